@@ -23,6 +23,8 @@
 #include "ensemble.h"
 #include "outils.h"
 #include "fifo.h"
+#include "parcours_parallele.h"
+#include "specialisation.h"
 
 #include <search.h>
 #include <stdio.h>
@@ -34,153 +36,146 @@
 
 #include <math.h>
 
-void action_get_max_etat (const intptr_t element, void* data) {
-	int* max = (int*) data;
-	if (*max < element) *max = element;
-}
-
 int get_max_etat( const Automate* automate ){
-	int max = INT_MIN;
-	
-	pour_tout_element (automate->etats, action_get_max_etat, &max);
-	
-	return max;
-}
-
-void action_get_min_etat( const intptr_t element, void* data ){
-	int * min = (int*) data;
-	if( *min > element ) *min = element;
+	// Les états sont triés : le plus grand est le dernier de l'ensemble.
+	Ensemble_curseur it = dernier_curseur_ensemble( automate->etats );
+	if( curseur_ensemble_est_vide( it ) ){
+		return INT_MIN;
+	}
+	return get_element_curseur( it );
 }
 
 int get_min_etat( const Automate* automate ){
-	int min = INT_MAX;
-
-	pour_tout_element( automate->etats, action_get_min_etat, &min );
-
-	return min;
+	Ensemble_curseur it = premier_curseur_ensemble( automate->etats );
+	if( curseur_ensemble_est_vide( it ) ){
+		return INT_MAX;
+	}
+	return get_element_curseur( it );
 }
 
-int comparer_cle(const Cle *a, const Cle *b) {
-	if( a->origine < b->origine )
-		return -1;
-	if( a->origine > b->origine )
-		return 1;
-	if( a->lettre < b->lettre )
-		return -1;
-	if( a->lettre > b->lettre )
-		return 1;
-	return 0;
-}
+/*
+ * Les clés de la table des transitions sont rangées dans un seul entier : 
+ * l'origine dans les bits de poids fort, la lettre dans l'octet de poids
+ * faible. L'ordre des entiers est celui des couples (origine, lettre), et la
+ * table n'a ni à allouer ses clés ni à les comparer par un pointeur de 
+ * fonction.
+ */
+_Static_assert(
+	sizeof(intptr_t) > sizeof(int), 
+	"Une clé (origine, lettre) doit tenir dans un intptr_t"
+);
 
-void print_cle( const Cle * a){
-	printf( "(%d, %c)" , a->origine, (char) (a->lettre) );
+intptr_t empaqueter_cle( int origine, char lettre ){
+	return (intptr_t) origine * 256 + ( (int) lettre - CHAR_MIN );
 }
 
-void supprimer_cle( Cle* cle ){
-	xfree( cle );
+Cle depaqueter_cle( intptr_t cle ){
+	Cle res;
+	int octet = (int) ( (uintptr_t) cle & 0xFF );
+	res.origine = (int) ( ( cle - octet ) / 256 );
+	res.lettre = octet + CHAR_MIN;
+	return res;
 }
 
-void initialiser_cle( Cle* cle, int origine, char lettre ){
-	cle->origine = origine;
-	cle->lettre = (int) lettre;
+intptr_t cle_vers_entier( Cle cle ){
+	return empaqueter_cle( cle.origine, cle.lettre );
 }
 
-Cle * creer_cle( int origine, char lettre ){
-	Cle * result = xmalloc( sizeof(Cle) );
-	initialiser_cle( result, origine, lettre );
-	return result;
-}
+// Accès typés et mis en ligne aux états, aux lettres et aux transitions
+DECLARER_ENSEMBLE( int, etats )
+DECLARER_ENSEMBLE( char, lettres )
+DECLARER_TABLE( Cle, Destinations *, transitions, cle_vers_entier, depaqueter_cle )
+
+// Les destinations d'une transition absente de l'automate
+static const Destinations destinations_vides = { 0, 0, { { 0 } } };
 
-Cle * copier_cle( const Cle* cle ){
-	return creer_cle( cle->origine, cle->lettre );
+void print_cle( intptr_t cle ){
+	Cle c = depaqueter_cle( cle );
+	printf( "(%d, %c)" , c.origine, (char) (c.lettre) );
 }
 
 Automate * creer_automate(){
 	Automate * automate = xmalloc( sizeof(Automate) );
 	automate->etats = creer_ensemble( NULL, NULL, NULL );
 	automate->alphabet = creer_ensemble( NULL, NULL, NULL );
-	automate->transitions = creer_table(
-		( int(*)(const intptr_t, const intptr_t) ) comparer_cle , 
-		( intptr_t (*)( const intptr_t ) ) copier_cle,
-		( void(*)(intptr_t) ) supprimer_cle
+	// Les Destinations sont rangées dans les noeuds de la table : seuls les
+	// ensembles d'arrivée de plus de NB_DESTINATIONS_EN_LIGNE états 
+	// allouent de la mémoire en plus de leur clé.
+	automate->transitions = creer_table_valeurs_en_ligne( 
+		NULL, NULL, NULL, sizeof(Destinations) 
 	);
 	automate->initiaux = creer_ensemble( NULL, NULL, NULL );
 	automate->finaux = creer_ensemble( NULL, NULL, NULL );
-	automate->vide = creer_ensemble( NULL, NULL, NULL ); 
+	automate->nb_references_transitions = xmalloc( sizeof(atomic_int) );
+	atomic_init( automate->nb_references_transitions, 1 );
+	automate->nb_cles_non_deterministes = 0;
 	return automate;
 }
 
-Automate * translater_automate_entier( const Automate* automate, int translation ){
-	Automate * res = creer_automate();
-
-	Ensemble_iterateur it;
-	for( 
-		it = premier_iterateur_ensemble( get_etats( automate ) );
-		! iterateur_ensemble_est_vide( it );
-		it = iterateur_suivant_ensemble( it )
-	){
-		ajouter_etat( res, get_element( it ) + translation );
-	}
-
-	for( 
-		it = premier_iterateur_ensemble( get_initiaux( automate ) );
-		! iterateur_ensemble_est_vide( it );
-		it = iterateur_suivant_ensemble( it )
-	){
-		ajouter_etat_initial( res, get_element( it ) + translation );
-	}
-
-	for( 
-		it = premier_iterateur_ensemble( get_finaux( automate ) );
-		! iterateur_ensemble_est_vide( it );
-		it = iterateur_suivant_ensemble( it )
-	){
-		ajouter_etat_final( res, get_element( it ) + translation );
+/*
+ * Abandonne la référence de l'automate sur sa table des transitions. La
+ * table est détruite si aucun autre automate ne la partage.
+ */
+void relacher_transitions( Automate * automate ){
+	if( atomic_fetch_sub( automate->nb_references_transitions, 1 ) == 1 ){
+		Table_curseur it;
+		for(
+			it = premier_curseur_table( automate->transitions );
+			! curseur_est_vide( it );
+			it = curseur_suivant_table( it )
+		){
+			vider_destinations( transitions_valeur( it ) );
+		}
+		liberer_table( automate->transitions );
+		xfree( automate->nb_references_transitions );
 	}
+}
 
-	// On ajoute les lettres
+/*
+ * Clone la table des transitions noeud par noeud. Les Destinations sont 
+ * recopiées avec leur noeud ; seuls les tableaux alloués sont dupliqués.
+ */
+Table * cloner_transitions( const Table * transitions ){
+	Table * res = cloner_table( transitions, NULL );
+	Table_curseur it;
 	for(
-		it = premier_iterateur_ensemble( get_alphabet( automate ) );
-		! iterateur_ensemble_est_vide( it );
-		it = iterateur_suivant_ensemble( it )
+		it = premier_curseur_table( res );
+		! curseur_est_vide( it );
+		it = curseur_suivant_table( it )
 	){
-		ajouter_lettre( res, (char) get_element( it ) );
+		detacher_destinations( transitions_valeur( it ) );
 	}
+	return res;
+}
 
-	Table_iterateur it1;
-	Ensemble_iterateur it2;
-	for(
-		it1 = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it1 );
-		it1 = iterateur_suivant_table( it1 )
-	){
-		Cle * cle = (Cle*) get_cle( it1 );
-		Ensemble * fins = (Ensemble*) get_valeur( it1 );
-		for(
-			it2 = premier_iterateur_ensemble( fins );
-			! iterateur_ensemble_est_vide( it2 );
-			it2 = iterateur_suivant_ensemble( it2 )
-		){
-			int fin = get_element( it2 );
-			ajouter_transition(
-				res, cle->origine + translation, cle->lettre, fin + translation
-			);
-		}
-	};
+/*
+ * Si la table des transitions est partagée avec d'autres automates (voir
+ * copier_automate()), l'automate en récupère une copie privée avant d'être
+ * modifié. Les destinations sont elles-mêmes copiées.
+ */
+void detacher_transitions( Automate * automate ){
+	if( atomic_load( automate->nb_references_transitions ) == 1 ) return;
+
+	Table * transitions = cloner_transitions( automate->transitions );
+	relacher_transitions( automate );
+	automate->transitions = transitions;
+	automate->nb_references_transitions = xmalloc( sizeof(atomic_int) );
+	atomic_init( automate->nb_references_transitions, 1 );
+}
 
+Automate * translater_automate_entier( const Automate* automate, int translation ){
+	Automate * res = creer_automate();
+	Vue_automate vue = creer_vue_automate( automate, translation );
+	ajouter_vue_automate( res, &vue );
 	return res;
 }
 
 
 void liberer_automate( Automate * automate ){
 	assert( automate );
-	liberer_ensemble( automate->vide );
 	liberer_ensemble( automate->finaux );
 	liberer_ensemble( automate->initiaux );
-	pour_toute_valeur_table(
-		automate->transitions, ( void(*)(intptr_t) ) liberer_ensemble
-	);
-	liberer_table( automate->transitions );
+	relacher_transitions( automate );
 	liberer_ensemble( automate->alphabet );
 	liberer_ensemble( automate->etats );
 	xfree(automate);
@@ -216,18 +211,246 @@ void ajouter_transition(
 	ajouter_etat( automate, origine );
 	ajouter_etat( automate, fin );
 	ajouter_lettre( automate, lettre );
+	detacher_transitions( automate );
+
+	Cle cle = { origine, lettre };
+	int ajoutee;
+	Destinations * destinations = inserer_cle_entiere( 
+		automate->transitions, cle_vers_entier( cle ), &ajoutee 
+	)->avl_value;
+	if( ajoutee ){
+		initialiser_destinations( destinations );
+	}
+	if( 
+		ajouter_destination( destinations, fin ) 
+		&& taille_destinations( destinations ) == 2
+	){
+		automate->nb_cles_non_deterministes++;
+	}
+}
 
-	Cle cle;
-	initialiser_cle( &cle, origine, lettre );
-	Table_iterateur it = trouver_table( automate->transitions, (intptr_t) &cle );
-	Ensemble * ens;
-	if( iterateur_est_vide( it ) ){
-		ens = creer_ensemble( NULL, NULL, NULL );
-		add_table( automate->transitions, (intptr_t) &cle, (intptr_t) ens );
-	}else{
-		ens = (Ensemble*) get_valeur( it );
+/*
+ * Une transition à trier avant son ajout en masse.
+ */
+typedef struct {
+	int origine;
+	int lettre;
+	int fin;
+} Transition_a_trier;
+
+int comparer_transitions_a_trier( const void* a, const void* b ){
+	const Transition_a_trier* t1 = (const Transition_a_trier*) a;
+	const Transition_a_trier* t2 = (const Transition_a_trier*) b;
+	if( t1->origine != t2->origine )
+		return t1->origine < t2->origine ? -1 : 1;
+	if( t1->lettre != t2->lettre )
+		return t1->lettre < t2->lettre ? -1 : 1;
+	if( t1->fin != t2->fin )
+		return t1->fin < t2->fin ? -1 : 1;
+	return 0;
+}
+
+int comparer_elements_a_trier( const void* a, const void* b ){
+	intptr_t e1 = *(const intptr_t*) a;
+	intptr_t e2 = *(const intptr_t*) b;
+	if( e1 < e2 ) return -1;
+	if( e1 > e2 ) return 1;
+	return 0;
+}
+
+/*
+ * Ajoute les transitions, triées dans l'ordre (origine, lettre, fin) avec 
+ * d'éventuels doublons consécutifs, à la table des transitions (déjà 
+ * détachée). Les états et les lettres ne sont pas ajoutés.
+ *
+ * Les ensembles d'arrivée sont construits clé par clé ; les clés sont 
+ * produites dans l'ordre de la table, qui est construite en temps linéaire
+ * si elle est vide.
+ */
+void ajouter_transitions_groupees(
+	Automate * automate, const int * origines, const char * lettres,
+	const int * fins, int n
+){
+	int i, j;
+	int table_vide = iterateur_est_vide(
+		premier_iterateur_table( automate->transitions )
+	);
+	intptr_t * cles = xmalloc( n * sizeof(intptr_t) );
+	intptr_t * valeurs = xmalloc( n * sizeof(intptr_t) );
+	// Les nouvelles Destinations, recopiées dans les noeuds de la table
+	Destinations * nouvelles = xmalloc( n * sizeof(Destinations) );
+	int * etats_fins = xmalloc( n * sizeof(int) );
+	int nb_cles = 0;
+	for( i=0; i<n; i=j ){
+		int nb_fins = 0;
+		for(
+			j = i;
+			j < n 
+			&& origines[j] == origines[i]
+			&& lettres[j] == lettres[i];
+			j++
+		){
+			if( nb_fins == 0 || etats_fins[nb_fins-1] != fins[j] ){
+				etats_fins[nb_fins++] = fins[j];
+			}
+		}
+		intptr_t cle = empaqueter_cle( origines[i], lettres[i] );
+		Destinations * destinations = NULL;
+		if( ! table_vide ){
+			Table_iterateur it = trouver_table( automate->transitions, cle );
+			if( ! iterateur_est_vide( it ) ){
+				destinations = (Destinations*) get_valeur( it );
+			}
+		}
+		if( destinations ){
+			int avant = taille_destinations( destinations );
+			ajouter_destinations_triees( destinations, etats_fins, nb_fins );
+			if( avant < 2 && taille_destinations( destinations ) >= 2 ){
+				automate->nb_cles_non_deterministes++;
+			}
+		}else{
+			destinations = &nouvelles[nb_cles];
+			initialiser_destinations( destinations );
+			ajouter_destinations_triees( destinations, etats_fins, nb_fins );
+			if( nb_fins >= 2 ){
+				automate->nb_cles_non_deterministes++;
+			}
+			cles[nb_cles] = cle;
+			valeurs[nb_cles] = (intptr_t) destinations;
+			nb_cles++;
+		}
+	}
+	add_table_triee( automate->transitions, cles, valeurs, nb_cles );
+
+	xfree( nouvelles );
+	xfree( etats_fins );
+	xfree( valeurs );
+	xfree( cles );
+}
+
+void ajouter_transitions_en_masse(
+	Automate * automate, const int * origines, const char * lettres,
+	const int * fins, int n
+){
+	int i;
+	if( n <= 0 ) return;
+	detacher_transitions( automate );
+
+	// On trie une seule fois toutes les transitions
+	Transition_a_trier * transitions = xmalloc( n * sizeof(Transition_a_trier) );
+	for( i=0; i<n; i++ ){
+		transitions[i].origine = origines[i];
+		transitions[i].lettre = (int) lettres[i];
+		transitions[i].fin = fins[i];
+	}
+	qsort( transitions, n, sizeof(Transition_a_trier), comparer_transitions_a_trier );
+
+	// On ajoute les états, triés et sans doublons
+	intptr_t * elements = xmalloc( 2 * n * sizeof(intptr_t) );
+	for( i=0; i<n; i++ ){
+		elements[2*i] = origines[i];
+		elements[2*i+1] = fins[i];
+	}
+	qsort( elements, 2*n, sizeof(intptr_t), comparer_elements_a_trier );
+	int nb_etats = 0;
+	for( i=0; i<2*n; i++ ){
+		if( nb_etats == 0 || elements[nb_etats-1] != elements[i] ){
+			elements[nb_etats++] = elements[i];
+		}
+	}
+	ajouter_elements_tries( automate->etats, elements, nb_etats );
+
+	// On ajoute les lettres dans l'ordre des entiers qui les codent
+	int presentes[UCHAR_MAX+1] = {0};
+	for( i=0; i<n; i++ ){
+		presentes[ (unsigned char) lettres[i] ] = 1;
+	}
+	int nb_lettres = 0;
+	for( i=CHAR_MIN; i<=CHAR_MAX; i++ ){
+		if( presentes[ (unsigned char) i ] ){
+			elements[nb_lettres++] = (char) i;
+		}
+	}
+	ajouter_elements_tries( automate->alphabet, elements, nb_lettres );
+
+	// On construit les ensembles d'arrivée à partir des transitions triées
+	int * origines_triees = xmalloc( n * sizeof(int) );
+	char * lettres_triees = xmalloc( n * sizeof(char) );
+	int * fins_triees = xmalloc( n * sizeof(int) );
+	for( i=0; i<n; i++ ){
+		origines_triees[i] = transitions[i].origine;
+		lettres_triees[i] = (char) transitions[i].lettre;
+		fins_triees[i] = transitions[i].fin;
+	}
+	ajouter_transitions_groupees( 
+		automate, origines_triees, lettres_triees, fins_triees, n 
+	);
+
+	xfree( fins_triees );
+	xfree( lettres_triees );
+	xfree( origines_triees );
+	xfree( elements );
+	xfree( transitions );
+}
+
+/*
+ * Renvoie 1 si les transitions sont strictement croissantes dans l'ordre 
+ * (origine, lettre, fin), et 0 sinon.
+ */
+int transitions_strictement_croissantes(
+	const int * origines, const char * lettres, const int * fins, int n
+){
+	int i;
+	for( i=1; i<n; i++ ){
+		if( origines[i-1] != origines[i] ){
+			if( origines[i-1] > origines[i] ) return 0;
+		}else if( lettres[i-1] != lettres[i] ){
+			if( lettres[i-1] > lettres[i] ) return 0;
+		}else if( fins[i-1] >= fins[i] ){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int ajouter_transitions_triees(
+	Automate * automate, const int * origines, const char * lettres,
+	const int * fins, int n
+){
+	int i;
+	if( ! transitions_strictement_croissantes( origines, lettres, fins, n ) ){
+		return 0;
+	}
+	if( n <= 0 ) return 1;
+	detacher_transitions( automate );
+
+	// Seuls les états et les lettres absents sont ajoutés, un par un
+	for( i=0; i<n; i++ ){
+		if( 
+			( i == 0 || origines[i-1] != origines[i] ) 
+			&& ! etats_contient( automate->etats, origines[i] ) 
+		){
+			etats_ajouter( automate->etats, origines[i] );
+		}
+		if( ! etats_contient( automate->etats, fins[i] ) ){
+			etats_ajouter( automate->etats, fins[i] );
+		}
+	}
+	int presentes[UCHAR_MAX+1] = {0};
+	for( i=0; i<n; i++ ){
+		presentes[ (unsigned char) lettres[i] ] = 1;
+	}
+	for( i=CHAR_MIN; i<=CHAR_MAX; i++ ){
+		if( 
+			presentes[ (unsigned char) i ] 
+			&& ! lettres_contient( automate->alphabet, (char) i ) 
+		){
+			lettres_ajouter( automate->alphabet, (char) i );
+		}
 	}
-	ajouter_element( ens, fin );
+
+	ajouter_transitions_groupees( automate, origines, lettres, fins, n );
+	return 1;
 }
 
 void ajouter_etat_final(
@@ -244,22 +467,20 @@ void ajouter_etat_initial(
 	ajouter_element( automate->initiaux, etat_initial );
 }
 
-const Ensemble * voisins( const Automate* automate, int origine, char lettre ){
-	Cle cle;
-	initialiser_cle( &cle, origine, lettre );
-	Table_iterateur it = trouver_table( automate->transitions, (intptr_t) &cle );
-	if( ! iterateur_est_vide( it ) ){
-		return (Ensemble*) get_valeur( it );
-	}else{
-		return automate->vide;
-	}
+const Destinations * voisins( 
+	const Automate* automate, int origine, char lettre 
+){
+	Cle cle = { origine, lettre };
+	return transitions_trouver( 
+		automate->transitions, cle, (Destinations *) &destinations_vides 
+	);
 }
 
 Ensemble * delta1(
 	const Automate* automate, int origine, char lettre
 ){
 	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
-	ajouter_elements( res, voisins( automate, origine, lettre ) );
+	ajouter_destinations_a_ensemble( res, voisins( automate, origine, lettre ) );
 	return res; 
 }
 
@@ -268,32 +489,72 @@ Ensemble * delta(
 ){
 	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
 
-	Ensemble_iterateur it;
+	Ensemble_curseur it;
 	for( 
-		it = premier_iterateur_ensemble( etats_courants );
-		! iterateur_ensemble_est_vide( it );
-		it = iterateur_suivant_ensemble( it )
+		it = premier_curseur_ensemble( etats_courants );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
 	){
-		const Ensemble * fins = voisins(
-			automate, get_element( it ), lettre
+		ajouter_destinations_a_ensemble( 
+			res, voisins( automate, etats_element( it ), lettre ) 
 		);
-		ajouter_elements( res, fins );
 	}
 
 	return res;
 }
 
+int est_deterministe( const Automate* automate ){
+	return automate->nb_cles_non_deterministes == 0
+		&& taille_ensemble( get_initiaux( automate ) ) <= 1;
+}
+
+/*
+ * Lit le mot à partir de l'état '*etat' d'un automate sans clé non 
+ * déterministe, en suivant un seul état. Renvoie 0 si une transition manque,
+ * et 1 sinon ; '*etat' est alors l'état d'arrivée.
+ */
+int lire_mot_deterministe( const Automate* automate, int * etat, const char* mot ){
+	int courant = *etat;
+	for( ; *mot; mot++ ){
+		const Destinations * fins = voisins( automate, courant, *mot );
+		if( taille_destinations( fins ) == 0 ){
+			return 0;
+		}
+		courant = etats_destinations( fins )[0];
+	}
+	*etat = courant;
+	return 1;
+}
+
 Ensemble * delta_star(
 	const Automate* automate, const Ensemble * etats_courants, const char* mot
 ){
+	if( 
+		automate->nb_cles_non_deterministes == 0 
+		&& taille_ensemble( etats_courants ) == 1
+	){
+		Ensemble * res = creer_ensemble( NULL, NULL, NULL );
+		int etat = etats_element( premier_curseur_ensemble( etats_courants ) );
+		if( lire_mot_deterministe( automate, &etat, mot ) ){
+			etats_ajouter( res, etat );
+		}
+		return res;
+	}
+
 	int len = strlen( mot );
 	int i;
-	Ensemble * old = copier_ensemble( etats_courants );
-	Ensemble * new = old;
-	for( i=0; i<len; i++ ){
+	// L'ensemble de départ n'est jamais copié avec copier_ensemble() : 
+	// il peut appartenir à un automate partagé entre plusieurs threads.
+	if( len == 0 ){
+		Ensemble * res = creer_ensemble( NULL, NULL, NULL );
+		ajouter_elements( res, etats_courants );
+		return res;
+	}
+	Ensemble * new = delta( automate, etats_courants, *mot );
+	for( i=1; i<len; i++ ){
+		Ensemble * old = new;
 		new = delta( automate, old, *(mot+i) );
 		liberer_ensemble( old );
-		old = new;
 	}
 	return new;
 }
@@ -303,124 +564,230 @@ void pour_toute_transition(
 	void (* action )( int origine, char lettre, int fin, void* data ),
 	void* data
 ){
-	Table_iterateur it1;
-	Ensemble_iterateur it2;
+	Table_curseur it;
+	int i;
 	for(
-		it1 = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it1 );
-		it1 = iterateur_suivant_table( it1 )
+		it = premier_curseur_table( automate->transitions );
+		! curseur_est_vide( it );
+		it = curseur_suivant_table( it )
 	){
-		Cle * cle = (Cle*) get_cle( it1 );
-		Ensemble * fins = (Ensemble*) get_valeur( it1 );
-		for(
-			it2 = premier_iterateur_ensemble( fins );
-			! iterateur_ensemble_est_vide( it2 );
-			it2 = iterateur_suivant_ensemble( it2 )
-		){
-			int fin = get_element( it2 );
-			action( cle->origine, cle->lettre, fin, data );
+		Cle cle = transitions_cle( it );
+		const Destinations * fins = transitions_valeur( it );
+		const int * etats = etats_destinations( fins );
+		for( i=0; i<taille_destinations( fins ); i++ ){
+			action( cle.origine, cle.lettre, etats[i], data );
 		}
 	};
 }
 
 Automate* copier_automate( const Automate* automate ){
-	Automate * res = creer_automate();
-	Ensemble_iterateur it1;
-	// On ajoute les états de l'automate
-	for(
-		it1 = premier_iterateur_ensemble( get_etats( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_etat( res, get_element( it1 ) );
-	}
-	// On ajoute les états initiaux
-	for(
-		it1 = premier_iterateur_ensemble( get_initiaux( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_etat_initial( res, get_element( it1 ) );
-	}
-	// On ajoute les états finaux
-	for(
-		it1 = premier_iterateur_ensemble( get_finaux( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_etat_final( res, get_element( it1 ) );
-	}
-	// On ajoute les lettres
-	for(
-		it1 = premier_iterateur_ensemble( get_alphabet( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_lettre( res, (char) get_element( it1 ) );
-	}
-	// On ajoute les transitions
-	Table_iterateur it2;
-	for(
-		it2 = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it2 );
-		it2 = iterateur_suivant_table( it2 )
-	){
-		Cle * cle = (Cle*) get_cle( it2 );
-		Ensemble * fins = (Ensemble*) get_valeur( it2 );
-		for(
-			it1 = premier_iterateur_ensemble( fins );
-			! iterateur_ensemble_est_vide( it1 );
-			it1 = iterateur_suivant_ensemble( it1 )
-		){
-			int fin = get_element( it1 );
-			ajouter_transition( res, cle->origine, cle->lettre, fin );
-		}
-	}
+	Automate * res = xmalloc( sizeof(Automate) );
+	res->etats = copier_ensemble( automate->etats );
+	res->alphabet = copier_ensemble( automate->alphabet );
+	res->initiaux = copier_ensemble( automate->initiaux );
+	res->finaux = copier_ensemble( automate->finaux );
+	// La table des transitions est partagée jusqu'à la prochaine modification
+	res->transitions = automate->transitions;
+	res->nb_references_transitions = automate->nb_references_transitions;
+	atomic_fetch_add( res->nb_references_transitions, 1 );
+	res->nb_cles_non_deterministes = automate->nb_cles_non_deterministes;
+	return res;
+}
+
+Automate* cloner_automate( const Automate* automate ){
+	Automate * res = xmalloc( sizeof(Automate) );
+	res->etats = cloner_ensemble( automate->etats );
+	res->alphabet = cloner_ensemble( automate->alphabet );
+	res->initiaux = cloner_ensemble( automate->initiaux );
+	res->finaux = cloner_ensemble( automate->finaux );
+	res->transitions = cloner_transitions( automate->transitions );
+	res->nb_references_transitions = xmalloc( sizeof(atomic_int) );
+	atomic_init( res->nb_references_transitions, 1 );
+	res->nb_cles_non_deterministes = automate->nb_cles_non_deterministes;
 	return res;
 }
 
 Automate * translater_automate(
 	const Automate * automate, const Automate * automate_a_eviter
+){
+	Vue_automate vue = creer_vue_automate_a_eviter( automate, automate_a_eviter );
+	return translater_automate_entier( automate, vue.translation );
+}
+
+Vue_automate creer_vue_automate( const Automate* automate, int translation ){
+	Vue_automate vue;
+	vue.automate = automate;
+	vue.translation = translation;
+	return vue;
+}
+
+Vue_automate creer_vue_automate_a_eviter(
+	const Automate * automate, const Automate * automate_a_eviter
 ){
 	if(
 		taille_ensemble( get_etats(automate) ) == 0 ||
 		taille_ensemble( get_etats(automate_a_eviter) ) == 0
 	){
-		return copier_automate( automate );
+		return creer_vue_automate( automate, 0 );
 	}
-	
-	int translation = 
-		get_max_etat( automate_a_eviter ) - get_min_etat( automate ) + 1; 
+	return creer_vue_automate(
+		automate, get_max_etat( automate_a_eviter ) - get_min_etat( automate ) + 1
+	);
+}
 
-	return translater_automate_entier( automate, translation );
-	
+void pour_tout_etat_translate(
+	const Ensemble* etats, int translation,
+	void (* action )( int etat, void* data ), void* data
+){
+	Ensemble_curseur it;
+	for(
+		it = premier_curseur_ensemble( etats );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
+	){
+		action( get_element_curseur( it ) + translation, data );
+	}
+}
+
+void pour_tout_etat_vue(
+	const Vue_automate* vue, void (* action )( int etat, void* data ),
+	void* data
+){
+	pour_tout_etat_translate(
+		get_etats( vue->automate ), vue->translation, action, data
+	);
+}
+
+void pour_tout_etat_initial_vue(
+	const Vue_automate* vue, void (* action )( int etat, void* data ),
+	void* data
+){
+	pour_tout_etat_translate(
+		get_initiaux( vue->automate ), vue->translation, action, data
+	);
+}
+
+void pour_tout_etat_final_vue(
+	const Vue_automate* vue, void (* action )( int etat, void* data ),
+	void* data
+){
+	pour_tout_etat_translate(
+		get_finaux( vue->automate ), vue->translation, action, data
+	);
+}
+
+void pour_tout_voisin_vue(
+	const Vue_automate* vue, int origine, char lettre,
+	void (* action )( int etat, void* data ), void* data
+){
+	const Destinations * fins = voisins( 
+		vue->automate, origine - vue->translation, lettre 
+	);
+	const int * etats = etats_destinations( fins );
+	int i;
+	for( i=0; i<taille_destinations( fins ); i++ ){
+		action( etats[i] + vue->translation, data );
+	}
+}
+
+typedef struct {
+	void (* action )( int origine, char lettre, int fin, void* data );
+	void* data;
+	int translation;
+} data_pour_toute_transition_vue_t;
+
+void action_pour_toute_transition_vue(
+	int origine, char lettre, int fin, void* data
+){
+	data_pour_toute_transition_vue_t* info = 
+		(data_pour_toute_transition_vue_t*) data;
+	info->action(
+		origine + info->translation, lettre, fin + info->translation,
+		info->data
+	);
+}
+
+void pour_toute_transition_vue(
+	const Vue_automate* vue,
+	void (* action )( int origine, char lettre, int fin, void* data ),
+	void* data
+){
+	data_pour_toute_transition_vue_t info;
+	info.action = action;
+	info.data = data;
+	info.translation = vue->translation;
+	pour_toute_transition(
+		vue->automate, action_pour_toute_transition_vue, &info
+	);
+}
+
+int est_un_etat_de_la_vue( const Vue_automate* vue, int etat ){
+	return est_un_etat_de_l_automate( vue->automate, etat - vue->translation );
+}
+
+int est_un_etat_final_de_la_vue( const Vue_automate* vue, int etat ){
+	return est_un_etat_final_de_l_automate(
+		vue->automate, etat - vue->translation
+	);
+}
+
+void action_ajouter_etat_vue( int etat, void* automate ){
+	ajouter_etat( (Automate*) automate, etat );
+}
+
+void action_ajouter_etat_initial_vue( int etat, void* automate ){
+	ajouter_etat_initial( (Automate*) automate, etat );
+}
+
+void action_ajouter_etat_final_vue( int etat, void* automate ){
+	ajouter_etat_final( (Automate*) automate, etat );
+}
+
+void action_ajouter_lettre_vue( const intptr_t lettre, void* automate ){
+	ajouter_lettre( (Automate*) automate, (char) lettre );
+}
+
+void action_ajouter_transition_vue(
+	int origine, char lettre, int fin, void* automate
+){
+	ajouter_transition( (Automate*) automate, origine, lettre, fin );
+}
+
+void ajouter_vue_automate( Automate* automate, const Vue_automate* vue ){
+	pour_tout_etat_vue( vue, action_ajouter_etat_vue, automate );
+	pour_tout_etat_initial_vue( vue, action_ajouter_etat_initial_vue, automate );
+	pour_tout_etat_final_vue( vue, action_ajouter_etat_final_vue, automate );
+	pour_tout_element(
+		get_alphabet( vue->automate ), action_ajouter_lettre_vue, automate
+	);
+	pour_toute_transition_vue( vue, action_ajouter_transition_vue, automate );
 }
 
 int est_une_transition_de_l_automate(
 	const Automate* automate,
 	int origine, char lettre, int fin
 ){
-	return est_dans_l_ensemble( voisins( automate, origine, lettre ), fin );
+	return contient_destination( voisins( automate, origine, lettre ), fin );
 }
 
 int est_un_etat_de_l_automate( const Automate* automate, int etat ){
-	return est_dans_l_ensemble( get_etats( automate ), etat );
+	return etats_contient( get_etats( automate ), etat );
 }
 
 int est_un_etat_initial_de_l_automate( const Automate* automate, int etat ){
-	return est_dans_l_ensemble( get_initiaux( automate ), etat );
+	return etats_contient( get_initiaux( automate ), etat );
 }
 
 int est_un_etat_final_de_l_automate( const Automate* automate, int etat ){
-	return est_dans_l_ensemble( get_finaux( automate ), etat );
+	return etats_contient( get_finaux( automate ), etat );
 }
 
 int est_une_lettre_de_l_automate( const Automate* automate, char lettre ){
-	return est_dans_l_ensemble( get_alphabet( automate ), lettre );
+	return lettres_contient( get_alphabet( automate ), lettre );
 }
 
-void print_ensemble_2( const intptr_t ens ){
-	print_ensemble( (Ensemble*) ens, NULL );
+void print_destinations_2( const intptr_t destinations ){
+	print_destinations( (const Destinations*) destinations );
 }
 
 void print_lettre( intptr_t c ){
@@ -440,24 +807,34 @@ void print_automate( const Automate * automate ){
 	print_table( 
 		automate->transitions,
 		( void (*)( const intptr_t ) ) print_cle, 
-		( void (*)( const intptr_t ) ) print_ensemble_2,
+		( void (*)( const intptr_t ) ) print_destinations_2,
 		""
 	);
 	printf("\n");
 }
 
 int le_mot_est_reconnu( const Automate* automate, const char* mot ){
+	// Automate déterministe : aucun ensemble n'est alloué
+	if( est_deterministe( automate ) ){
+		if( taille_ensemble( get_initiaux( automate ) ) == 0 ){
+			return 0;
+		}
+		int etat = etats_element( premier_curseur_ensemble( get_initiaux( automate ) ) );
+		return lire_mot_deterministe( automate, &etat, mot )
+			&& est_un_etat_final_de_l_automate( automate, etat );
+	}
+
 	Ensemble * arrivee = delta_star( automate, get_initiaux(automate) , mot ); 
 	
 	int result = 0;
 
-	Ensemble_iterateur it;
+	Ensemble_curseur it;
 	for(
-		it = premier_iterateur_ensemble( arrivee );
-		! iterateur_ensemble_est_vide( it );
-		it = iterateur_suivant_ensemble( it )
+		it = premier_curseur_ensemble( arrivee );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
 	){
-		if( est_un_etat_final_de_l_automate( automate, get_element(it) ) ){
+		if( est_un_etat_final_de_l_automate( automate, get_element_curseur(it) ) ){
 			result = 1;
 			break;
 		}
@@ -466,6 +843,58 @@ int le_mot_est_reconnu( const Automate* automate, const char* mot ){
 	return result;
 }
 
+/*
+ * Compte la mémoire d'un des ensembles de l'automate.
+ */
+void compter_ensemble_automate( 
+	const Ensemble * ensemble, Memoire * memoire, Memoire * noeuds_avl 
+){
+	Ensemble_memoire_stats stats;
+	ensemble_memoire( ensemble, &stats );
+	*memoire = stats.total;
+	ajouter_memoire( noeuds_avl, stats.table.noeuds );
+}
+
+void automate_memoire( const Automate* automate, Automate_memoire_stats* stats ){
+	memset( stats, 0, sizeof(Automate_memoire_stats) );
+	compter_memoire( &stats->automate, 1, sizeof(Automate) );
+	compter_memoire( &stats->automate, 1, sizeof(atomic_int) );
+	compter_ensemble_automate( 
+		automate->etats, &stats->etats, &stats->noeuds_avl 
+	);
+	compter_ensemble_automate( 
+		automate->alphabet, &stats->alphabet, &stats->noeuds_avl 
+	);
+	compter_ensemble_automate( 
+		automate->initiaux, &stats->initiaux, &stats->noeuds_avl 
+	);
+	compter_ensemble_automate( 
+		automate->finaux, &stats->finaux, &stats->noeuds_avl 
+	);
+
+	Table_memoire_stats transitions;
+	table_memoire( automate->transitions, &transitions );
+	stats->cles_transitions = transitions.total;
+	ajouter_memoire( &stats->noeuds_avl, transitions.noeuds );
+
+	Table_curseur it;
+	for(
+		it = premier_curseur_table( automate->transitions );
+		! curseur_est_vide( it );
+		it = curseur_suivant_table( it )
+	){
+		destinations_memoire( transitions_valeur( it ), &stats->destinations );
+	}
+
+	ajouter_memoire( &stats->total, stats->automate );
+	ajouter_memoire( &stats->total, stats->etats );
+	ajouter_memoire( &stats->total, stats->alphabet );
+	ajouter_memoire( &stats->total, stats->initiaux );
+	ajouter_memoire( &stats->total, stats->finaux );
+	ajouter_memoire( &stats->total, stats->cles_transitions );
+	ajouter_memoire( &stats->total, stats->destinations );
+}
+
 Automate * mot_to_automate( const char * mot ){
 	Automate * automate = creer_automate();
 	int i = 0;
@@ -478,38 +907,414 @@ Automate * mot_to_automate( const char * mot ){
 	return automate;
 }
 
-void action_ajout_initiaux_union ( const intptr_t element, void* data ){
-	ajouter_etat_initial (data, element);
-}
-
-void action_ajout_finaux_union ( const intptr_t element, void* data ){
-	ajouter_etat_final (data, element);
-}
-
-void action_ajout_transitions_union ( int origine, char lettre, int fin, void* data ){
-	ajouter_transition (data, origine, lettre, fin);
-}
-
 Automate * creer_union_des_automates(
 	const Automate * automate_1, const Automate * automate_2
 ){
-	// Renommage des sommet de l'automate_2 pour qu'il n'est pas les mêmes noms que ceux de l'automate_1
-	Automate * automate_2_bis = translater_automate(automate_2, automate_1);
+	// Renommage des sommet de l'automate_2 pour qu'il n'est pas les mêmes noms que ceux de l'automate_1.
+	// La vue évite seulement une copie translatée intermédiaire de 
+	// l'automate_2 : ses transitions sont tout de même ajoutées une à une à
+	// l'union.
+	Vue_automate automate_2_bis = creer_vue_automate_a_eviter(automate_2, automate_1);
 	
 	// ajout des états et des transitions de l'automate_1 à celui de l'union
 	Automate * automate_union = copier_automate (automate_1);
 	
-	// Ajout à l'automate de l'union des états finaux et initiaux de l'automate_2 
-	pour_tout_element (get_initiaux (automate_2_bis), action_ajout_initiaux_union, automate_union);
-	pour_tout_element (get_finaux (automate_2_bis), action_ajout_finaux_union, automate_union);
-	
-	// ajout des transitions de l'automate_2 à l'automate de l'union, ainsi que les états de 2 qui n'ont
-	// pas encore été ajouté
-	pour_toute_transition (automate_2_bis, action_ajout_transitions_union, automate_union);
+	// Ajout à l'automate de l'union des états, des lettres, des états finaux et initiaux 
+	// et des transitions de l'automate_2
+	ajouter_vue_automate (automate_union, &automate_2_bis);
 	
 	return automate_union;
 }
 
+void fusionner_automates( Automate * destination, Automate * source ){
+	// On garde les arbres du plus gros automate, et seul le plus petit est 
+	// renuméroté et recopié.
+	if(
+		taille_ensemble( get_etats( destination ) ) + 
+		taille_table( destination->transitions ) <
+		taille_ensemble( get_etats( source ) ) + 
+		taille_table( source->transitions )
+	){
+		Automate tmp = *destination;
+		*destination = *source;
+		*source = tmp;
+	}
+
+	Vue_automate vue;
+	if( get_max_etat( destination ) < get_min_etat( source ) ){
+		// Les états sont déjà disjoints
+		vue = creer_vue_automate( source, 0 );
+	}else{
+		vue = creer_vue_automate_a_eviter( source, destination );
+	}
+	ajouter_vue_automate( destination, &vue );
+	liberer_automate( source );
+}
+
+/*
+ * Ajoute à l'automate 'res' une transition (origine, lettre, fin) pour chaque
+ * état 'origine' de 'origines' et chaque transition (initial, lettre, fin) 
+ * de la vue partant d'un état initial de la vue.
+ *
+ * C'est ce qui remplace une epsilon-transition de chaque état de 'origines'
+ * vers chaque état initial de la vue.
+ */
+void relier_aux_initiaux(
+	Automate * res, const Ensemble * origines, const Vue_automate * vue
+){
+	const Automate * automate = vue->automate;
+	Ensemble_curseur it_initial, it_lettre, it_origine;
+	int i;
+	for(
+		it_initial = premier_curseur_ensemble( get_initiaux( automate ) );
+		! curseur_ensemble_est_vide( it_initial );
+		it_initial = curseur_suivant_ensemble( it_initial )
+	){
+		for(
+			it_lettre = premier_curseur_ensemble( get_alphabet( automate ) );
+			! curseur_ensemble_est_vide( it_lettre );
+			it_lettre = curseur_suivant_ensemble( it_lettre )
+		){
+			char lettre = (char) get_element_curseur( it_lettre );
+			const Destinations * fins = voisins(
+				automate, get_element_curseur( it_initial ), lettre
+			);
+			const int * etats = etats_destinations( fins );
+			for( i=0; i<taille_destinations( fins ); i++ ){
+				for(
+					it_origine = premier_curseur_ensemble( origines );
+					! curseur_ensemble_est_vide( it_origine );
+					it_origine = curseur_suivant_ensemble( it_origine )
+				){
+					ajouter_transition(
+						res, get_element_curseur( it_origine ), lettre,
+						etats[i] + vue->translation
+					);
+				}
+			}
+		}
+	}
+}
+
+int reconnait_le_mot_vide( const Automate * automate ){
+	Ensemble * commun = creer_intersection_ensemble(
+		get_initiaux( automate ), get_finaux( automate )
+	);
+	int result = taille_ensemble( commun ) != 0;
+	liberer_ensemble( commun );
+	return result;
+}
+
+Automate * creer_concatenation_des_automates(
+	const Automate * automate_1, const Automate * automate_2
+){
+	// Seul l'automate_2 est renuméroté, et il n'est pas recopié
+	Vue_automate vue = creer_vue_automate_a_eviter( automate_2, automate_1 );
+
+	Automate * res = copier_automate( automate_1 );
+
+	// Les états finaux de l'automate_1 ne restent finaux que si l'automate_2
+	// reconnaît le mot vide.
+	if( ! reconnait_le_mot_vide( automate_2 ) ){
+		vider_ensemble( res->finaux );
+	}
+
+	pour_tout_etat_vue( &vue, action_ajouter_etat_vue, res );
+	pour_tout_etat_final_vue( &vue, action_ajouter_etat_final_vue, res );
+	pour_tout_element(
+		get_alphabet( automate_2 ), action_ajouter_lettre_vue, res
+	);
+	pour_toute_transition_vue( &vue, action_ajouter_transition_vue, res );
+
+	// Les états finaux de l'automate_1 lisent ce que lisent les états 
+	// initiaux de l'automate_2
+	relier_aux_initiaux( res, get_finaux( automate_1 ), &vue );
+
+	return res;
+}
+
+/*
+ * Renvoie un état qui n'est pas dans l'automate : le successeur du plus 
+ * grand état, ou à défaut le prédécesseur du plus petit, ou à défaut le 
+ * premier trou entre deux états consécutifs.
+ */
+int etat_libre( const Automate * automate ){
+	if( taille_ensemble( get_etats( automate ) ) == 0 ){
+		return 0;
+	}
+	int max = get_max_etat( automate );
+	if( max < INT_MAX ){
+		return max + 1;
+	}
+	int min = get_min_etat( automate );
+	if( min > INT_MIN ){
+		return min - 1;
+	}
+	Ensemble_curseur it = premier_curseur_ensemble( get_etats( automate ) );
+	int precedent = etats_element( it );
+	for(
+		it = curseur_suivant_ensemble( it );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
+	){
+		int etat = etats_element( it );
+		if( etat != precedent + 1 ){
+			return precedent + 1;
+		}
+		precedent = etat;
+	}
+	ERREUR( "Tous les états possibles sont utilisés" );
+	return 0;
+}
+
+Automate * creer_etoile_automate( const Automate * automate ){
+	Automate * res = copier_automate( automate );
+
+	// Un nouvel état, initial et final, reconnaît le mot vide. Les anciens 
+	// états initiaux ne sont plus initiaux : on ne doit pas pouvoir y revenir
+	// sans avoir lu un mot du langage.
+	int nouvel_etat = etat_libre( automate );
+	vider_ensemble( res->initiaux );
+	ajouter_etat_initial( res, nouvel_etat );
+	ajouter_etat_final( res, nouvel_etat );
+
+	Vue_automate vue = creer_vue_automate( automate, 0 );
+	Ensemble * origines = copier_ensemble( get_finaux( automate ) );
+	ajouter_element( origines, nouvel_etat );
+	relier_aux_initiaux( res, origines, &vue );
+	liberer_ensemble( origines );
+
+	return res;
+}
+
+/*
+ * Donne le numéro suivant à un état qui n'a pas encore été numéroté.
+ */
+void numeroter_etat( Table * numeros, int * ordre, int * nb_numerotes, int etat ){
+	if( iterateur_est_vide( trouver_table( numeros, etat ) ) ){
+		add_table( numeros, etat, *nb_numerotes );
+		ordre[ *nb_numerotes ] = etat;
+		(*nb_numerotes)++;
+	}
+}
+
+typedef struct {
+	Table * numeros;
+	int * origines;
+	char * lettres;
+	int * fins;
+	int nb_transitions;
+} data_compacter_t;
+
+void action_compacter_transition( int origine, char lettre, int fin, void* data ){
+	data_compacter_t * info = (data_compacter_t*) data;
+	int i = info->nb_transitions++;
+	info->origines[i] = get_valeur( trouver_table( info->numeros, origine ) );
+	info->lettres[i] = lettre;
+	info->fins[i] = get_valeur( trouver_table( info->numeros, fin ) );
+}
+
+void action_compter_transition( int origine, char lettre, int fin, void* data ){
+	(*(int*) data) += 1;
+}
+
+Table * compacter_automate( Automate * automate ){
+	int n = taille_ensemble( get_etats( automate ) );
+	int * ordre = xmalloc( ( n + 1 ) * sizeof(int) );
+	int nb_numerotes = 0;
+	Table * numeros = creer_table( NULL, NULL, NULL );
+	Ensemble_curseur it, it_lettre;
+
+	// Parcours en largeur à partir des états initiaux : 'ordre' sert de file.
+	for(
+		it = premier_curseur_ensemble( get_initiaux( automate ) );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
+	){
+		numeroter_etat( numeros, ordre, &nb_numerotes, get_element_curseur( it ) );
+	}
+	int tete;
+	for( tete = 0; tete < nb_numerotes; tete++ ){
+		for(
+			it_lettre = premier_curseur_ensemble( get_alphabet( automate ) );
+			! curseur_ensemble_est_vide( it_lettre );
+			it_lettre = curseur_suivant_ensemble( it_lettre )
+		){
+			const Destinations * fins = voisins(
+				automate, ordre[tete], (char) get_element_curseur( it_lettre )
+			);
+			const int * etats = etats_destinations( fins );
+			int i;
+			for( i=0; i<taille_destinations( fins ); i++ ){
+				numeroter_etat( numeros, ordre, &nb_numerotes, etats[i] );
+			}
+		}
+	}
+	// Les états non accessibles sont numérotés à la suite
+	for(
+		it = premier_curseur_ensemble( get_etats( automate ) );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
+	){
+		numeroter_etat( numeros, ordre, &nb_numerotes, get_element_curseur( it ) );
+	}
+
+	Automate * compact = creer_automate();
+	intptr_t * etats = xmalloc( ( n + 1 ) * sizeof(intptr_t) );
+	int i;
+	for( i=0; i<n; i++ ){
+		etats[i] = i;
+	}
+	ajouter_elements_tries( compact->etats, etats, n );
+	xfree( etats );
+	ajouter_elements( compact->alphabet, get_alphabet( automate ) );
+	for(
+		it = premier_curseur_ensemble( get_initiaux( automate ) );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
+	){
+		ajouter_etat_initial(
+			compact, get_valeur( trouver_table( numeros, get_element_curseur( it ) ) )
+		);
+	}
+	for(
+		it = premier_curseur_ensemble( get_finaux( automate ) );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
+	){
+		ajouter_etat_final(
+			compact, get_valeur( trouver_table( numeros, get_element_curseur( it ) ) )
+		);
+	}
+
+	data_compacter_t data;
+	int nb_transitions = 0;
+	pour_toute_transition( automate, action_compter_transition, &nb_transitions );
+	data.numeros = numeros;
+	data.origines = xmalloc( ( nb_transitions + 1 ) * sizeof(int) );
+	data.lettres = xmalloc( ( nb_transitions + 1 ) * sizeof(char) );
+	data.fins = xmalloc( ( nb_transitions + 1 ) * sizeof(int) );
+	data.nb_transitions = 0;
+	pour_toute_transition( automate, action_compacter_transition, &data );
+	ajouter_transitions_en_masse(
+		compact, data.origines, data.lettres, data.fins, data.nb_transitions
+	);
+	xfree( data.origines );
+	xfree( data.lettres );
+	xfree( data.fins );
+	xfree( ordre );
+
+	// L'automate récupère le contenu de l'automate compacté
+	Automate tmp = *automate;
+	*automate = *compact;
+	*compact = tmp;
+	liberer_automate( compact );
+
+	return numeros;
+}
+
+/*
+ * Les transitions étiquetées par une lettre, dans l'ordre croissant des 
+ * origines.
+ */
+typedef struct {
+	int origine;
+	const Destinations * fins;
+} Transition_de_lettre;
+
+typedef struct {
+	unsigned char lettre;
+	int nb_transitions;
+	Transition_de_lettre * transitions;
+} Signature_lettre;
+
+int comparer_signatures_lettres( const void* a, const void* b ){
+	const Signature_lettre * s1 = (const Signature_lettre *) a;
+	const Signature_lettre * s2 = (const Signature_lettre *) b;
+	if( s1->nb_transitions != s2->nb_transitions ){
+		return ( s1->nb_transitions < s2->nb_transitions ) ? -1 : 1;
+	}
+	int i;
+	for( i=0; i<s1->nb_transitions; i++ ){
+		const Transition_de_lettre * t1 = &s1->transitions[i];
+		const Transition_de_lettre * t2 = &s2->transitions[i];
+		if( t1->origine != t2->origine ){
+			return ( t1->origine < t2->origine ) ? -1 : 1;
+		}
+		int cmp = comparer_destinations( t1->fins, t2->fins );
+		if( cmp ){
+			return cmp;
+		}
+	}
+	return 0;
+}
+
+void calculer_classes_de_lettres( 
+	const Automate * automate, Classes_lettres * classes 
+){
+	Signature_lettre signatures[256];
+	int i;
+	for( i=0; i<256; i++ ){
+		signatures[i].lettre = i;
+		signatures[i].nb_transitions = 0;
+		signatures[i].transitions = NULL;
+	}
+
+	Table_curseur it;
+	for(
+		it = premier_curseur_table( automate->transitions );
+		! curseur_est_vide( it );
+		it = curseur_suivant_table( it )
+	){
+		Cle cle = depaqueter_cle( get_cle_curseur( it ) );
+		signatures[ (unsigned char) cle.lettre ].nb_transitions++;
+	}
+	for( i=0; i<256; i++ ){
+		if( signatures[i].nb_transitions ){
+			signatures[i].transitions = xmalloc( 
+				signatures[i].nb_transitions * sizeof(Transition_de_lettre)
+			);
+			signatures[i].nb_transitions = 0;
+		}
+	}
+	// Les clés sont triées par origine : chaque signature l'est aussi.
+	for(
+		it = premier_curseur_table( automate->transitions );
+		! curseur_est_vide( it );
+		it = curseur_suivant_table( it )
+	){
+		Cle cle = depaqueter_cle( get_cle_curseur( it ) );
+		Signature_lettre * signature = &signatures[ (unsigned char) cle.lettre ];
+		Transition_de_lettre * t = 
+			&signature->transitions[ signature->nb_transitions++ ];
+		t->origine = cle.origine;
+		t->fins = transitions_valeur( it );
+	}
+
+	// Les lettres sans transitions, s'il y en a, sont en tête et forment la
+	// classe 0.
+	qsort( signatures, 256, sizeof(Signature_lettre), comparer_signatures_lettres );
+	classes->nb_classes = 0;
+	for( i=0; i<256; i++ ){
+		if( 
+			i == 0 || 
+			comparer_signatures_lettres( &signatures[i-1], &signatures[i] ) 
+		){
+			classes->nb_classes++;
+		}
+		classes->classe[ signatures[i].lettre ] = classes->nb_classes - 1;
+	}
+	for( i=0; i<256; i++ ){
+		if( signatures[i].transitions ){
+			xfree( signatures[i].transitions );
+		}
+	}
+}
+
+int classe_de_lettre( const Classes_lettres * classes, char lettre ){
+	return classes->classe[ (unsigned char) lettre ];
+}
+
 Ensemble* etats_accessibles( const Automate * automate, int etat ){
 	// Récupération de l'alphabet
 	const Ensemble* alphabet = get_alphabet (automate);
@@ -522,28 +1327,28 @@ Ensemble* etats_accessibles( const Automate * automate, int etat ){
 	Ensemble* dest;
 	
 	// itérateur permettant de parcourrir l'ensemble de l'alphabet
-	Ensemble_iterateur it_alphabet ;
+	Ensemble_curseur it_alphabet ;
 	
 	// On répète la procédure tant qu'on trouve de nouveaux états
 	do {
 		ajouter_elements (accessibles_old, accessibles_new);
 		
 		// on place l'it sur la première lettre
-		it_alphabet = premier_iterateur_ensemble (alphabet);
+		it_alphabet = premier_curseur_ensemble (alphabet);
 		
 		// Parcours des lettre de l'alphabet
-		while (!iterateur_ensemble_est_vide (it_alphabet)) {
+		while (!curseur_ensemble_est_vide (it_alphabet)) {
 			// On récupère les états accessibles avec une lettre de l'alphabet depuis les états accessibles récupérés
-			dest = delta (automate, accessibles_old, get_element (it_alphabet));
+			dest = delta (automate, accessibles_old, get_element_curseur (it_alphabet));
 			
 			// accessible_new = accessible_new UNION dest et on libère dest
 			transferer_elements_et_libere (accessibles_new, dest);
 			
 			// On passe à la lettre suivante
-			it_alphabet = iterateur_suivant_ensemble (it_alphabet);
+			it_alphabet = curseur_suivant_ensemble (it_alphabet);
 		}
 		
-	} while (comparer_ensemble (accessibles_new, accessibles_old));
+	} while (!ensembles_egaux (accessibles_new, accessibles_old));
 	
 	liberer_ensemble (accessibles_old);
 	
@@ -558,18 +1363,18 @@ Ensemble* accessibles( const Automate * automate ){
 	Ensemble* dest;
 	
 	// On se place sur le premier état initial
-	Ensemble_iterateur it_initiaux = premier_iterateur_ensemble (initiaux);
+	Ensemble_curseur it_initiaux = premier_curseur_ensemble (initiaux);
 	
 	// On fait l'union des états accessibles depuis tous les états initiaux
-	while (!iterateur_ensemble_est_vide (it_initiaux)) {
+	while (!curseur_ensemble_est_vide (it_initiaux)) {
 		// récupération des états accessibles depuis un état initial
-		dest = etats_accessibles (automate, get_element (it_initiaux));
+		dest = etats_accessibles (automate, get_element_curseur (it_initiaux));
 		
 		// On effectue l'union avec les états récupéré jusque là et on libère de la mémoire
 		transferer_elements_et_libere (etats_accessibles_depuis_initiaux, dest);
 		
 		// Etat initial suivant
-		it_initiaux = iterateur_suivant_ensemble (it_initiaux);
+		it_initiaux = curseur_suivant_ensemble (it_initiaux);
 	}
 	
 	return etats_accessibles_depuis_initiaux;
@@ -580,9 +1385,20 @@ void action_ajout_transition_automate_accessible (int origine, char lettre, int
 		ajouter_transition(data, origine, lettre, fin);
 }
 
+/*
+ * Nombre d'états à partir duquel automate_accessible() utilise un parcours
+ * parallèle.
+ */
+#define SEUIL_PARCOURS_PARALLELE 100000
+
 Automate *automate_accessible( const Automate * automate ){
 	// Récupération des états accessibles dans un automate depuis des états initiaux
-	Ensemble* ens_etats_accessible = accessibles (automate);
+	Ensemble* ens_etats_accessible;
+	if( taille_ensemble( get_etats( automate ) ) >= SEUIL_PARCOURS_PARALLELE ){
+		ens_etats_accessible = accessibles_parallele( automate, 0 );
+	}else{
+		ens_etats_accessible = accessibles (automate);
+	}
 	
 	// Les états finaux de l'automate accessible sont les états finaux accessible de automate
 	Ensemble* nouv_etats_finaux = creer_intersection_ensemble (ens_etats_accessible, get_finaux (automate));
@@ -591,12 +1407,15 @@ Automate *automate_accessible( const Automate * automate ){
 	Automate* nouv_automate = creer_automate ();
 	
 	// Les états accessibles de automate deviennent les états du nouvel automate
+	liberer_ensemble (nouv_automate->etats);
 	nouv_automate->etats = ens_etats_accessible;
 	
 	// Même états initiaux
+	liberer_ensemble (nouv_automate->initiaux);
 	nouv_automate->initiaux = copier_ensemble (get_initiaux (automate));
 	
 	// états finaux caculés précédemment
+	liberer_ensemble (nouv_automate->finaux);
 	nouv_automate->finaux = nouv_etats_finaux;
 	
 	// On parcours toute les transitions de l'automate source, si la transition lie deux états équivalent dans le nouvel automate on l'ajoute a celui ci
@@ -609,35 +1428,36 @@ Automate *miroir( const Automate * automate){
 	Automate * res = creer_automate();
 	
 	// Le miroir a les mêmes états que l'automate source
+	liberer_ensemble (res->etats);
 	res->etats = copier_ensemble (get_etats (automate));
 	
 	// On transforme les états finaux en initiaux
+	liberer_ensemble (res->initiaux);
 	res->initiaux = copier_ensemble (get_finaux (automate));
 	
 	// On transforme les états initiaux en finaux
+	liberer_ensemble (res->finaux);
 	res->finaux = copier_ensemble (get_initiaux (automate));
 	
 	// On parcours la toutes les transitions de l'automate
-	Table_iterateur it;
-	for(it = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it );
-		it = iterateur_suivant_table( it )
+	Table_curseur it;
+	for(it = premier_curseur_table( automate->transitions );
+		! curseur_est_vide( it );
+		it = curseur_suivant_table( it )
 	){
-		Table_iterateur it2;
+		int i;
 		
 		// Récupération de l'état d'origine de la transition et de la lettre associée
-		Cle * cle = (Cle*) get_cle( it );
+		Cle cle = transitions_cle( it );
 		
 		// récupération des états de destination
-		Ensemble * dest = (Ensemble*) get_valeur( it );
+		const Destinations * dest = transitions_valeur( it );
 		
 		// On inverse les transitions récupérées
-		for(it2 = premier_iterateur_ensemble( dest );
-			! iterateur_ensemble_est_vide( it2 );
-			it2 = iterateur_suivant_ensemble( it2 )
-		){
-			int dest = get_element( it2 );
-			ajouter_transition( res, dest, cle->lettre, cle->origine );
+		for( i=0; i<taille_destinations( dest ); i++ ){
+			ajouter_transition( 
+				res, etats_destinations( dest )[i], cle.lettre, cle.origine 
+			);
 		}
 	}
 	
@@ -700,19 +1520,19 @@ void ajouter_transitions_melange (
 	liberer_automate (automate);
 	
 	// Parcours des états de destination
-	Ensemble_iterateur it_dest = premier_iterateur_ensemble (dest);
-	while(!iterateur_ensemble_est_vide (it_dest)){
+	Ensemble_curseur it_dest = premier_curseur_ensemble (dest);
+	while(!curseur_ensemble_est_vide (it_dest)){
 		
 		// Construction des nouveaux couples en fonction de l'état src choisi précédemment :
 		// on remplace dans les nouveaux couple l'état source par les états de destination
 		My_couple c = malloc (sizeof (*c));
 		if (num_automate == 1){ // état de l'automate_1 du couple
-			c->aut1 = get_element (it_dest);
+			c->aut1 = get_element_curseur (it_dest);
 			c->aut2 = ((My_couple) get_element (it_nouv_etats))->aut2;
 		}
 		else{ // état de l'automate_2 du couple
 			c->aut1 = ((My_couple) get_element (it_nouv_etats))->aut1;
-			c->aut2 = get_element (it_dest);
+			c->aut2 = get_element_curseur (it_dest);
 		}
 		
 		// Si le couple n'est pas déjà associé à un sommet du mélange, on l'ajoute à la table assiciative
@@ -731,7 +1551,7 @@ void ajouter_transitions_melange (
 							get_valeur (trouver_table (nouv_etats, (intptr_t) c)));
 		
 		// état suivant de destination
-		it_dest = iterateur_suivant_ensemble (it_dest);
+		it_dest = curseur_suivant_ensemble (it_dest);
 	}
 	// On libère l'ensemble des états de destination
 	liberer_ensemble (dest);
@@ -755,8 +1575,8 @@ Automate * creer_automate_du_melange(
 	const Ensemble* initiaux_aut_2 = get_initiaux (automate_2);
 	
 	// Initialisation des itérateurs pour le parcours des initiaux
-	Ensemble_iterateur it_initiaux_1 = premier_iterateur_ensemble (initiaux_aut_1);
-	Ensemble_iterateur it_initiaux_2;
+	Ensemble_curseur it_initiaux_1 = premier_curseur_ensemble (initiaux_aut_1);
+	Ensemble_curseur it_initiaux_2;
 	
 	// Numéro des nouveaux états du mélange
 	int id_etat = 0;
@@ -764,14 +1584,14 @@ Automate * creer_automate_du_melange(
 	// On construit les couples d'états (aut1, aut2) tel que
 	// aut1 (resp. aut2) appartient à l'automate_1 (resp. automate_2)
 	// et on associe ces couples à un nouvel état du mélange
-	while (!iterateur_ensemble_est_vide (it_initiaux_1)) {
-		it_initiaux_2 = premier_iterateur_ensemble (initiaux_aut_2);
+	while (!curseur_ensemble_est_vide (it_initiaux_1)) {
+		it_initiaux_2 = premier_curseur_ensemble (initiaux_aut_2);
 		
-		while (!iterateur_ensemble_est_vide (it_initiaux_2)) {
+		while (!curseur_ensemble_est_vide (it_initiaux_2)) {
 			// Construction du couple d'états
 			My_couple c = malloc (sizeof (*c));
-			c->aut1 = get_element (it_initiaux_1);
-			c->aut2 = get_element (it_initiaux_2);
+			c->aut1 = get_element_curseur (it_initiaux_1);
+			c->aut2 = get_element_curseur (it_initiaux_2);
 			
 			// Le nouvel état est un état initial du mélange
 			ajouter_etat_initial (mela, id_etat);
@@ -782,11 +1602,11 @@ Automate * creer_automate_du_melange(
 			++id_etat;
 			
 			// état de l'automate_2 suivant
-			it_initiaux_2 = iterateur_suivant_ensemble (it_initiaux_2);
+			it_initiaux_2 = curseur_suivant_ensemble (it_initiaux_2);
 		}
 		
 		// état de l'automate_1 suivant
-		it_initiaux_1 = iterateur_suivant_ensemble (it_initiaux_1);
+		it_initiaux_1 = curseur_suivant_ensemble (it_initiaux_1);
 	}
 	
 	// construction de l'union de l'alphabet de l'automate_1 et de l'automate_2
@@ -796,19 +1616,19 @@ Automate * creer_automate_du_melange(
 	// On parcours la table qui associe les couples et leur numéro dans le mélange
 	// En calculant les transitions qui sortent des états pour chaque lettre de l'alphabet construit
 	Table_iterateur it_nouv_etats = premier_iterateur_table (nouv_etats);
-	Ensemble_iterateur it_alphabet;
+	Ensemble_curseur it_alphabet;
 	
 	int nb_nouv_etats_new = taille_table (nouv_etats);
 	int nb_nouv_etats_old = nb_nouv_etats_new;
 	
 	while (!iterateur_est_vide (it_nouv_etats)){
-		it_alphabet = premier_iterateur_ensemble (nouv_alphabet);
-		while (!iterateur_ensemble_est_vide (it_alphabet)) {
+		it_alphabet = premier_curseur_ensemble (nouv_alphabet);
+		while (!curseur_ensemble_est_vide (it_alphabet)) {
 			nb_nouv_etats_old = nb_nouv_etats_new;
 			
 			// Calcul des transitions à partir de l'état de l'automate_1 du couple
 			ajouter_transitions_melange (1, nouv_etats, automate_1, automate_2, it_nouv_etats, 
-											get_element (it_alphabet), &id_etat, mela);
+											get_element_curseur (it_alphabet), &id_etat, mela);
 			
 			
 			nb_nouv_etats_new = taille_table (nouv_etats);
@@ -816,7 +1636,7 @@ Automate * creer_automate_du_melange(
 			// Si l'opération n'a pas ajouter d'état on calcul les transitions à partir de l'état de l'automate_2
 			if (nb_nouv_etats_new == nb_nouv_etats_old) {
 				ajouter_transitions_melange (2, nouv_etats, automate_1, automate_2, it_nouv_etats, 
-												get_element (it_alphabet), &id_etat, mela);
+												get_element_curseur (it_alphabet), &id_etat, mela);
 				nb_nouv_etats_new = taille_table (nouv_etats);
 			}
 			
@@ -824,11 +1644,11 @@ Automate * creer_automate_du_melange(
 			// Alors on recommence le parcours de la liste associative et de l'alphabet
 			// (au cas ou des couples auraient été ajoutés avant l'itérateur de la liste associative courant)
 			if (nb_nouv_etats_new > nb_nouv_etats_old) {
-				it_alphabet = premier_iterateur_ensemble (nouv_alphabet);
+				it_alphabet = premier_curseur_ensemble (nouv_alphabet);
 				it_nouv_etats = premier_iterateur_table (nouv_etats);
 			}
 			else // Si aucun état n'a été ajouté on passe à la lettre suivante
-				it_alphabet = iterateur_suivant_ensemble (it_alphabet);
+				it_alphabet = curseur_suivant_ensemble (it_alphabet);
 		}
 		
 		// On passe à l'état suivant
@@ -841,3 +1661,199 @@ Automate * creer_automate_du_melange(
 	return mela;
 }
 
+
+/*
+ * Structure union-find utilisée par l'algorithme de Hopcroft et Karp.
+ *
+ * Chaque noeud correspond à un état de l'un des deux automates, ou à l'état
+ * puits (implicite) de l'un des deux automates. Les noeuds sont créés au fur
+ * et à mesure de l'exploration des couples d'états.
+ */
+typedef struct {
+	const Automate* automates[2];
+	Table* noeuds[2];  // état de l'automate i -> numéro du noeud
+	int puits[2];      // noeud du puits de l'automate i, -1 s'il n'existe pas
+	int* parent;
+	int* rang;
+	int* cote;         // automate (0 ou 1) auquel appartient le noeud
+	int* etat;         // état associé au noeud, sans signification pour un puits
+	int* est_puits;
+	int nb_noeuds;
+	int capacite;
+} Union_find_automates;
+
+int creer_noeud_union_find( Union_find_automates* uf, int cote, int etat, int puits ){
+	if( uf->nb_noeuds == uf->capacite ){
+		uf->capacite = 2*uf->capacite;
+		uf->parent = xrealloc( uf->parent, uf->capacite * sizeof(int) );
+		uf->rang = xrealloc( uf->rang, uf->capacite * sizeof(int) );
+		uf->cote = xrealloc( uf->cote, uf->capacite * sizeof(int) );
+		uf->etat = xrealloc( uf->etat, uf->capacite * sizeof(int) );
+		uf->est_puits = xrealloc( uf->est_puits, uf->capacite * sizeof(int) );
+	}
+	int noeud = uf->nb_noeuds++;
+	uf->parent[noeud] = noeud;
+	uf->rang[noeud] = 0;
+	uf->cote[noeud] = cote;
+	uf->etat[noeud] = etat;
+	uf->est_puits[noeud] = puits;
+	return noeud;
+}
+
+int noeud_du_puits( Union_find_automates* uf, int cote ){
+	if( uf->puits[cote] < 0 ){
+		uf->puits[cote] = creer_noeud_union_find( uf, cote, 0, 1 );
+	}
+	return uf->puits[cote];
+}
+
+int noeud_de_l_etat( Union_find_automates* uf, int cote, int etat ){
+	Table_iterateur it = trouver_table( uf->noeuds[cote], etat );
+	if( ! iterateur_est_vide( it ) ){
+		return get_valeur( it );
+	}
+	int noeud = creer_noeud_union_find( uf, cote, etat, 0 );
+	add_table( uf->noeuds[cote], etat, noeud );
+	return noeud;
+}
+
+int trouver_union_find( Union_find_automates* uf, int noeud ){
+	int racine = noeud;
+	while( uf->parent[racine] != racine ){
+		racine = uf->parent[racine];
+	}
+	// Compression des chemins
+	while( uf->parent[noeud] != racine ){
+		int suivant = uf->parent[noeud];
+		uf->parent[noeud] = racine;
+		noeud = suivant;
+	}
+	return racine;
+}
+
+void unir_union_find( Union_find_automates* uf, int racine_1, int racine_2 ){
+	if( uf->rang[racine_1] < uf->rang[racine_2] ){
+		uf->parent[racine_1] = racine_2;
+	}else if( uf->rang[racine_1] > uf->rang[racine_2] ){
+		uf->parent[racine_2] = racine_1;
+	}else{
+		uf->parent[racine_2] = racine_1;
+		uf->rang[racine_1]++;
+	}
+}
+
+int noeud_est_final( Union_find_automates* uf, int noeud ){
+	return ! uf->est_puits[noeud] && est_un_etat_final_de_l_automate(
+		uf->automates[ uf->cote[noeud] ], uf->etat[noeud]
+	);
+}
+
+int noeud_initial( Union_find_automates* uf, int cote ){
+	const Ensemble * initiaux = get_initiaux( uf->automates[cote] );
+	assert( taille_ensemble( initiaux ) <= 1 );
+	Ensemble_curseur it = premier_curseur_ensemble( initiaux );
+	if( curseur_ensemble_est_vide( it ) ){
+		return noeud_du_puits( uf, cote );
+	}
+	return noeud_de_l_etat( uf, cote, get_element_curseur( it ) );
+}
+
+int noeud_suivant( Union_find_automates* uf, int noeud, char lettre ){
+	int cote = uf->cote[noeud];
+	if( uf->est_puits[noeud] ){
+		return noeud;
+	}
+	const Destinations * fins = voisins( 
+		uf->automates[cote], uf->etat[noeud], lettre 
+	);
+	assert( taille_destinations( fins ) <= 1 );
+	if( taille_destinations( fins ) == 0 ){
+		return noeud_du_puits( uf, cote );
+	}
+	return noeud_de_l_etat( uf, cote, etats_destinations( fins )[0] );
+}
+
+int les_automates_deterministes_sont_equivalents(
+	const Automate * automate_1, const Automate * automate_2
+){
+	Union_find_automates uf;
+	uf.automates[0] = automate_1;
+	uf.automates[1] = automate_2;
+	uf.noeuds[0] = creer_table( NULL, NULL, NULL );
+	uf.noeuds[1] = creer_table( NULL, NULL, NULL );
+	uf.puits[0] = -1;
+	uf.puits[1] = -1;
+	uf.nb_noeuds = 0;
+	uf.capacite = 16;
+	uf.parent = xmalloc( uf.capacite * sizeof(int) );
+	uf.rang = xmalloc( uf.capacite * sizeof(int) );
+	uf.cote = xmalloc( uf.capacite * sizeof(int) );
+	uf.etat = xmalloc( uf.capacite * sizeof(int) );
+	uf.est_puits = xmalloc( uf.capacite * sizeof(int) );
+
+	// On lit les lettres des deux alphabets : une lettre absente de l'un des
+	// automates mène simplement dans son puits.
+	Ensemble * alphabet = creer_union_ensemble(
+		get_alphabet( automate_1 ), get_alphabet( automate_2 )
+	);
+	int nb_lettres = taille_ensemble( alphabet );
+	char * lettres = xmalloc( ( nb_lettres + 1 ) * sizeof(char) );
+	int i = 0;
+	Ensemble_curseur it;
+	for(
+		it = premier_curseur_ensemble( alphabet );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
+	){
+		lettres[i++] = (char) get_element_curseur( it );
+	}
+	liberer_ensemble( alphabet );
+
+	int result = 1;
+	Fifo * a_traiter = creer_fifo();
+
+	int initial_1 = noeud_initial( &uf, 0 );
+	int initial_2 = noeud_initial( &uf, 1 );
+	if( noeud_est_final( &uf, initial_1 ) != noeud_est_final( &uf, initial_2 ) ){
+		result = 0;
+	}else{
+		unir_union_find( &uf, initial_1, initial_2 );
+		ajouter_fifo( a_traiter, initial_1 );
+		ajouter_fifo( a_traiter, initial_2 );
+	}
+
+	// Chaque couple fusionné est exploré une seule fois : il y a au plus 
+	// autant de fusions que de noeuds.
+	while( result && ! est_vide( a_traiter ) ){
+		int noeud_1 = retirer_fifo( a_traiter );
+		int noeud_2 = retirer_fifo( a_traiter );
+		for( i=0; i<nb_lettres; i++ ){
+			int suivant_1 = noeud_suivant( &uf, noeud_1, lettres[i] );
+			int suivant_2 = noeud_suivant( &uf, noeud_2, lettres[i] );
+			int racine_1 = trouver_union_find( &uf, suivant_1 );
+			int racine_2 = trouver_union_find( &uf, suivant_2 );
+			if( racine_1 == racine_2 ) continue;
+			if(
+				noeud_est_final( &uf, suivant_1 ) !=
+				noeud_est_final( &uf, suivant_2 )
+			){
+				result = 0;
+				break;
+			}
+			unir_union_find( &uf, racine_1, racine_2 );
+			ajouter_fifo( a_traiter, suivant_1 );
+			ajouter_fifo( a_traiter, suivant_2 );
+		}
+	}
+
+	liberer_fifo( a_traiter );
+	xfree( lettres );
+	liberer_table( uf.noeuds[0] );
+	liberer_table( uf.noeuds[1] );
+	xfree( uf.parent );
+	xfree( uf.rang );
+	xfree( uf.cote );
+	xfree( uf.etat );
+	xfree( uf.est_puits );
+	return result;
+}
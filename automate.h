@@ -24,6 +24,9 @@
 #define __AUTOMATE_H__
 
 #include "ensemble.h"
+#include "destinations.h"
+
+#include <stdatomic.h>
 
 /**
  * @brief Le type d'un automate.
@@ -34,24 +37,73 @@
  * pas d'epsilon transition.
  * L'automate codé peut avoir plusieurs états initiaux.
  * 
+ * Un même automate peut être partagé entre plusieurs threads tant qu'aucun
+ * ne le modifie : toutes les fonctions qui prennent un `const Automate*` 
+ * (le_mot_est_reconnu(), delta(), delta_star(), voisins(), les prédicats 
+ * est_...(), les itérations pour_tout_...()) ne font que lire l'automate,
+ * sans allouer de mémoire partagée ni modifier de compteur. Les copies 
+ * obtenues avec copier_automate() partagent leurs arbres avec l'original,
+ * mais les compteurs de références sont atomiques et chaque copie récupère 
+ * un arbre privé avant d'être modifiée : un thread peut donc modifier sa 
+ * propre copie pendant que les autres lisent l'original.
  */
 
 struct Automate {
-   Ensemble * vide; //!<
 	Ensemble * etats;
 	Ensemble * alphabet;
-	Table* transitions;
+	Table* transitions; //!< Associe à chaque clé (origine, lettre) ses Destinations.
 	Ensemble * initiaux;
 	Ensemble * finaux;
+	atomic_int * nb_references_transitions; //!< Nombre d'automates partageant 'transitions'.
+	int nb_cles_non_deterministes; //!< Nombre de clés (origine, lettre) ayant plusieurs Destinations.
 };
 
 typedef struct Automate Automate;
 
+/**
+ * @brief Clé de la table des transitions, une fois dépaquetée.
+ *
+ * Dans la table, le couple (origine, lettre) est rangé dans un seul 
+ * intptr_t.
+ */
 typedef struct Cle {
 	int origine;
 	int lettre;
 } Cle;
 
+/**
+ * @brief Partition des lettres en classes d'équivalence.
+ *
+ * Deux lettres sont dans la même classe lorsqu'elles étiquettent exactement 
+ * les mêmes transitions (mêmes origines et mêmes états d'arrivée). Une table
+ * de transitions dense peut alors avoir nb_classes colonnes au lieu de 256,
+ * les lettres étant converties en classes par classe[(unsigned char) lettre].
+ */
+typedef struct Classes_lettres {
+	unsigned char classe[256]; //!< Classe de chaque lettre.
+	int nb_classes; //!< Nombre de classes, entre 1 et 256.
+} Classes_lettres;
+
+/**
+ * @brief Détail de la mémoire occupée par un automate.
+ *
+ * Les champs 'automate' à 'destinations' forment une partition de la 
+ * mémoire de l'automate, et leur somme est 'total'. Le champ 'noeuds_avl' 
+ * regroupe les noeuds AVL de tous les ensembles et de la table des 
+ * transitions, déjà comptés dans les autres champs.
+ */
+typedef struct Automate_memoire_stats {
+	Memoire automate; //!< La structure Automate et son compteur de références.
+	Memoire etats; //!< L'ensemble des états.
+	Memoire alphabet; //!< L'alphabet.
+	Memoire initiaux; //!< L'ensemble des états initiaux.
+	Memoire finaux; //!< L'ensemble des états finaux.
+	Memoire cles_transitions; //!< La table des transitions, dont les noeuds portent les clés (origine, lettre) et leurs Destinations.
+	Memoire destinations; //!< Les tableaux alloués des Destinations qui ne tiennent plus dans leur noeud.
+	Memoire noeuds_avl; //!< Tous les noeuds AVL (déjà comptés ci-dessus).
+	Memoire total; //!< La mémoire totale.
+} Automate_memoire_stats;
+
 /**
  * @brief Crée un automate vide, sans états, sans lettres et sans transitions.
  *
@@ -97,6 +149,59 @@ void ajouter_transition(
 	Automate * automate, int origine, char lettre, int fin
 );
 
+/**
+ * @brief Ajoute en une seule fois 'n' transitions à l'automate passé en 
+ *        paramètre.
+ *
+ * La i-ème transition est ('origines'[i], 'lettres'[i], 'fins'[i]). Comme 
+ * pour ajouter_transition(), les états et les lettres sont ajoutés 
+ * automatiquement à l'automate. Les transitions peuvent être données dans 
+ * n'importe quel ordre et contenir des doublons.
+ *
+ * Les transitions sont triées une seule fois, puis les arbres des états, de 
+ * l'alphabet et des transitions sont construits directement en temps 
+ * linéaire lorsqu'ils sont vides. C'est donc le moyen le plus rapide de 
+ * construire un gros automate.
+ *
+ * @param automate Un automate.
+ * @param origines Les origines des transitions.
+ * @param lettres Les lettres des transitions.
+ * @param fins Les fins des transitions.
+ * @param n Le nombre de transitions.
+ */ 
+void ajouter_transitions_en_masse(
+	Automate * automate, const int * origines, const char * lettres,
+	const int * fins, int n
+);
+
+/**
+ * @brief Ajoute en une seule fois 'n' transitions déjà triées à l'automate 
+ *        passé en paramètre.
+ *
+ * Les transitions doivent être strictement croissantes dans l'ordre 
+ * (origine, lettre, fin), les lettres étant comparées comme des char : 
+ * c'est l'ordre de pour_toute_transition(). L'ordre est vérifié ; s'il 
+ * n'est pas respecté, l'automate n'est pas modifié.
+ *
+ * Contrairement à ajouter_transitions_en_masse(), les transitions ne sont 
+ * pas recopiées ni triées : l'arbre des transitions est construit en temps 
+ * linéaire s'il est vide. Les états et les lettres qui ne sont pas encore 
+ * dans l'automate sont ajoutés un par un : il vaut donc mieux ajouter les 
+ * états avant les transitions.
+ *
+ * @param automate Un automate.
+ * @param origines Les origines des transitions.
+ * @param lettres Les lettres des transitions.
+ * @param fins Les fins des transitions.
+ * @param n Le nombre de transitions.
+ * @return 1 si les transitions ont été ajoutées, 0 si elles ne sont pas 
+ *         triées.
+ */ 
+int ajouter_transitions_triees(
+	Automate * automate, const int * origines, const char * lettres,
+	const int * fins, int n
+);
+
 /**
  * @brief Ajoute un état final à un automate passé en paramètre.
  *
@@ -166,6 +271,24 @@ const Ensemble * get_finaux( const Automate* automate );
  */ 
 const Ensemble * get_alphabet( const Automate* automate );
 
+/**
+ * @brief Renvoie l'ensemble des états accessibles à partir d'un état donné
+ *        en paramètre et en lisant une lettre donnée en paramètre.
+ *
+ * Contrairement à delta1(), la fonction ne fait aucune copie : la mémoire des
+ * destinations renvoyées est gérée par l'automate. L'utilisateur ne doit donc
+ * pas modifier ou libérer les destinations ainsi obtenues.
+ *
+ * Les états sont lus avec taille_destinations() et etats_destinations() : 
+ * une ou deux destinations sont rangées dans la structure elle-même.
+ *
+ * @param automate Un automate.
+ * @param origine Un état.
+ * @param lettre Une lettre.
+ * @return Les destinations, triées.
+ */ 
+const Destinations * voisins( const Automate* automate, int origine, char lettre );
+
 /**
  * @brief Renvoie 1 si ('origine', 'lettre', 'fin') est une transition de 
  *        l'automate et 0 sinon.
@@ -280,6 +403,23 @@ Ensemble * delta_star(
  */ 
 int le_mot_est_reconnu( const Automate* automate, const char* mot );
 
+/**
+ * @brief Renvoie 1 si l'automate est déterministe, et 0 sinon.
+ *
+ * Un automate est déterministe s'il a au plus un état initial et au plus un
+ * état d'arrivée pour chaque couple (état, lettre). Le nombre de couples 
+ * ayant plusieurs états d'arrivée est tenu à jour à chaque ajout de 
+ * transition : la fonction est en temps constant et ne modifie pas 
+ * l'automate.
+ *
+ * Lorsque l'automate est déterministe, delta_star() et le_mot_est_reconnu()
+ * suivent un seul état, sans construire d'ensemble à chaque lettre.
+ *
+ * @param automate Un automate.
+ * @return 1 ou 0.
+ */ 
+int est_deterministe( const Automate* automate );
+
 /**
  * @brief La fonction passe en revue toutes les transitions de l'automate et 
  *        appelle la fonction passée en paramètre.
@@ -325,7 +465,143 @@ Automate * translater_automate(
 Automate * translater_automate_entier( const Automate* automate, int translation );
 
 /**
- * @brief @todo Renvoie l'état ayant le numéro le plus grand de l'automate passé en 
+ * @brief Vue d'un automate dont les numéros de tous les états sont translatés
+ *        par un entier.
+ *
+ * Une vue ne recopie pas l'automate : elle le référence et applique la 
+ * translation à la volée lors de chaque lecture. L'automate référencé ne doit
+ * donc pas être libéré tant que la vue est utilisée.
+ */
+typedef struct Vue_automate {
+	const Automate * automate; //!< L'automate référencé.
+	int translation; //!< L'entier ajouté à tous les états de l'automate.
+} Vue_automate;
+
+/**
+ * @brief Renvoie une vue de l'automate passé en paramètre dont les numéros
+ *        des états sont translatés par un entier.
+ *
+ * @param automate L'automate à référencer.
+ * @param translation L'entier de translation.
+ * @return La vue.
+ */
+Vue_automate creer_vue_automate( const Automate* automate, int translation );
+
+/**
+ * @brief Renvoie une vue de l'automate passé en paramètre dont les états 
+ *        évitent ceux du second automate passé en paramètre.
+ *
+ * La translation est la même que celle utilisée par translater_automate().
+ *
+ * @param automate L'automate à référencer.
+ * @param automate_a_eviter L'automate à éviter.
+ * @return La vue.
+ */
+Vue_automate creer_vue_automate_a_eviter(
+	const Automate * automate, const Automate * automate_a_eviter
+);
+
+/**
+ * @brief Appelle la fonction passée en paramètre pour chaque état (translaté)
+ *        de la vue.
+ *
+ * @param vue Une vue.
+ * @param action La fonction à exécuter.
+ * @param data La donnée supplémentaire à passer en paramètre à 'action'.
+ */
+void pour_tout_etat_vue(
+	const Vue_automate* vue, void (* action )( int etat, void* data ),
+	void* data
+);
+
+/**
+ * @brief Appelle la fonction passée en paramètre pour chaque état initial
+ *        (translaté) de la vue.
+ *
+ * @param vue Une vue.
+ * @param action La fonction à exécuter.
+ * @param data La donnée supplémentaire à passer en paramètre à 'action'.
+ */
+void pour_tout_etat_initial_vue(
+	const Vue_automate* vue, void (* action )( int etat, void* data ),
+	void* data
+);
+
+/**
+ * @brief Appelle la fonction passée en paramètre pour chaque état final
+ *        (translaté) de la vue.
+ *
+ * @param vue Une vue.
+ * @param action La fonction à exécuter.
+ * @param data La donnée supplémentaire à passer en paramètre à 'action'.
+ */
+void pour_tout_etat_final_vue(
+	const Vue_automate* vue, void (* action )( int etat, void* data ),
+	void* data
+);
+
+/**
+ * @brief Appelle la fonction passée en paramètre pour chaque état (translaté)
+ *        accessible à partir de l'état 'origine' (translaté) de la vue en 
+ *        lisant la lettre 'lettre'.
+ *
+ * @param vue Une vue.
+ * @param origine Un état de la vue.
+ * @param lettre Une lettre.
+ * @param action La fonction à exécuter.
+ * @param data La donnée supplémentaire à passer en paramètre à 'action'.
+ */
+void pour_tout_voisin_vue(
+	const Vue_automate* vue, int origine, char lettre,
+	void (* action )( int etat, void* data ), void* data
+);
+
+/**
+ * @brief La fonction passe en revue toutes les transitions (translatées) de 
+ *        la vue et appelle la fonction passée en paramètre.
+ *
+ * Voir pour_toute_transition().
+ *
+ * @param vue Une vue.
+ * @param action La fonction à exécuter.
+ * @param data La donnée supplémentaire à passer en paramètre à 'action'.
+ */
+void pour_toute_transition_vue(
+	const Vue_automate* vue,
+	void (* action )( int origine, char lettre, int fin, void* data ),
+	void* data
+);
+
+/**
+ * @brief Renvoie 1 si ('etat') est un état de la vue et 0 sinon.
+ *
+ * @param vue Une vue.
+ * @param etat Un état (translaté).
+ * @return 1 ou 0.
+ */
+int est_un_etat_de_la_vue( const Vue_automate* vue, int etat );
+
+/**
+ * @brief Renvoie 1 si ('etat') est un état final de la vue et 0 sinon.
+ *
+ * @param vue Une vue.
+ * @param etat Un état (translaté).
+ * @return 1 ou 0.
+ */
+int est_un_etat_final_de_la_vue( const Vue_automate* vue, int etat );
+
+/**
+ * @brief Ajoute à un automate les états, les lettres et les transitions d'une
+ *        vue. Les états initiaux et finaux de la vue deviennent initiaux et 
+ *        finaux dans l'automate.
+ *
+ * @param automate L'automate à compléter.
+ * @param vue La vue à ajouter.
+ */
+void ajouter_vue_automate( Automate* automate, const Vue_automate* vue );
+
+/**
+ * @brief Renvoie l'état ayant le numéro le plus grand de l'automate passé en 
  *        paramètre.
  *
  * Si l'automate est vide (sans état), alors il renvoie INT_MIN.
@@ -353,11 +629,47 @@ int get_min_etat( const Automate* automate );
  * L'automate copié et l'automate à copier sont indépendants du point de vue de 
  * la mémoire.
  *
+ * La copie est faite en temps constant : les deux automates partagent leurs 
+ * ensembles et leur table de transitions jusqu'à ce que l'un d'eux soit 
+ * modifié (copie sur écriture). La copie est alors faite arbre par arbre, 
+ * et non chemin par chemin : la première modification d'un ensemble ou de 
+ * la table des transitions clone tout l'arbre concerné, en temps linéaire 
+ * en sa taille (les tableaux alloués des Destinations sont dupliqués avec lui).
+ * copier_automate() ne fait donc gagner du temps que si la copie ou 
+ * l'original n'est pas modifié, ou si seuls certains de ses arbres le sont.
+ *
  * @param automate L'automate à copier.
  * @return La copie de l'automate.
  */ 
 Automate* copier_automate( const Automate* automate );
 
+/**
+ * @brief Crée une copie profonde d'un automate.
+ *
+ * Contrairement à copier_automate(), la copie ne partage aucune mémoire avec
+ * l'automate d'origine. Tous les arbres (états, alphabet, transitions et 
+ * ensembles d'arrivée) sont clonés noeud par noeud en temps linéaire.
+ *
+ * @param automate L'automate à copier.
+ * @return La copie de l'automate.
+ */ 
+Automate* cloner_automate( const Automate* automate );
+
+/**
+ * @brief Calcule la mémoire occupée par un automate.
+ *
+ * Les nombres d'octets sont ceux demandés à xmalloc(). Les arbres partagés 
+ * avec d'autres automates (voir copier_automate()) sont comptés en entier, 
+ * comme si l'automate en était le seul propriétaire.
+ *
+ * Le calcul est linéaire en le nombre de clés de la table des transitions ;
+ * il ne modifie pas l'automate.
+ *
+ * @param automate Un automate.
+ * @param stats La mémoire calculée.
+ */ 
+void automate_memoire( const Automate* automate, Automate_memoire_stats* stats );
+
 /**
  * @brief Renvoie un automate qui reconnaît un unique mot passé en paramètre.
  *
@@ -389,6 +701,9 @@ Ensemble* accessibles( const Automate * automate );
  * @brief @todo Renvoie l'automate passé en paramètre dont les états non accessibles 
  *        ont été supprimés.
  *
+ * Pour les gros automates, les états accessibles sont calculés en parallèle
+ * avec accessibles_parallele().
+ *
  * @param automate Un automate.
  * @return L'automate accessible.
  */ 
@@ -429,6 +744,12 @@ void print_automate( const Automate * automate );
  * reconus par l'un des deux automates passés en 
  * paramètre.
  *
+ * Les deux automates sont recopiés : le premier avec copier_automate(), dont
+ * les arbres sont clonés au premier ajout, et le second transition par 
+ * transition à travers une vue translatée. Le coût est donc de l'ordre de la
+ * taille des deux automates ; fusionner_automates() évite ces copies quand 
+ * les automates d'origine ne sont plus utiles.
+ *
  * @param automate_1 Le premier automate.
  * @param automate_2 Le deuxième automate.
  * @return L'automate à créer.
@@ -437,6 +758,112 @@ Automate * creer_union_des_automates(
 	const Automate * automate_1, const Automate * automate_2
 );
 
+/**
+ * @brief Renumérote les états d'un automate de 0 à n-1, où n est le nombre 
+ *        d'états de l'automate.
+ *
+ * Les états sont numérotés dans l'ordre d'un parcours en largeur à partir 
+ * des états initiaux (les lettres et les états étant parcourus dans l'ordre
+ * croissant), puis les états non accessibles sont numérotés à la suite, dans
+ * l'ordre croissant. Des états voisins ont ainsi des numéros proches, et 
+ * les numéros peuvent servir d'indices dans des tableaux de taille n.
+ *
+ * La numérotation ne dépend que de la structure de l'automate : deux 
+ * automates déterministes accessibles qui ne diffèrent que par les numéros 
+ * de leurs états deviennent identiques une fois compactés.
+ *
+ * La table renvoyée associe à chaque ancien numéro d'état son nouveau 
+ * numéro. Sa mémoire est laissée à la charge de l'utilisateur, qui devra la
+ * libérer avec liberer_table().
+ *
+ * @param automate L'automate à renuméroter.
+ * @return La table de renumérotation.
+ */ 
+Table * compacter_automate( Automate * automate );
+
+/**
+ * @brief Calcule les classes d'équivalence des lettres d'un automate.
+ *
+ * Les 256 valeurs possibles d'un char sont réparties en classes : deux 
+ * lettres sont dans la même classe si, pour tout état, elles mènent au même
+ * ensemble d'états. Les lettres qui n'étiquettent aucune transition, y 
+ * compris celles qui ne sont pas dans l'alphabet, forment la classe 0 s'il 
+ * y en a. Si les 256 valeurs étiquettent toutes une transition, la classe 0
+ * est une classe de lettres comme les autres.
+ *
+ * Le calcul parcourt une seule fois les transitions puis trie les lettres
+ * selon leurs transitions ; son coût est de l'ordre de m log(256), où m est 
+ * le nombre de transitions.
+ *
+ * @param automate Un automate.
+ * @param classes Les classes calculées.
+ */ 
+void calculer_classes_de_lettres( 
+	const Automate * automate, Classes_lettres * classes 
+);
+
+/**
+ * @brief Renvoie la classe d'une lettre.
+ *
+ * @param classes Les classes calculées par calculer_classes_de_lettres().
+ * @param lettre Une lettre.
+ * @return La classe de la lettre.
+ */ 
+int classe_de_lettre( const Classes_lettres * classes, char lettre );
+
+/**
+ * @brief Crée la concaténation des automates.
+ *
+ * Cet automate reconnaît tous les mots u.v tels que u est reconnu par le 
+ * premier automate et v par le deuxième.
+ *
+ * Aucune epsilon-transition n'est utilisée : les transitions qui partent des
+ * états initiaux du deuxième automate sont ajoutées directement à partir des 
+ * états finaux du premier. Seul le deuxième automate est renuméroté, sans 
+ * être recopié.
+ *
+ * @param automate_1 Le premier automate.
+ * @param automate_2 Le deuxième automate.
+ * @return L'automate à créer.
+ */ 
+Automate * creer_concatenation_des_automates(
+	const Automate * automate_1, const Automate * automate_2
+);
+
+/**
+ * @brief Crée l'étoile de Kleene d'un automate.
+ *
+ * Cet automate reconnaît le mot vide et toutes les concaténations de mots 
+ * reconnus par l'automate passé en paramètre.
+ *
+ * Aucune epsilon-transition n'est utilisée : un nouvel état, à la fois 
+ * initial et final, remplace les états initiaux, et les transitions qui 
+ * partent des anciens états initiaux sont ajoutées à partir de ce nouvel état
+ * et de tous les états finaux.
+ *
+ * @param automate Un automate.
+ * @return L'automate à créer.
+ */ 
+Automate * creer_etoile_automate( const Automate * automate );
+
+/**
+ * @brief Remplace l'automate 'destination' par l'union des deux automates 
+ *        passés en paramètre, et libère l'automate 'source'.
+ *
+ * Contrairement à creer_union_des_automates(), aucun des deux automates n'est
+ * recopié entièrement : les arbres du plus gros automate sont récupérés tels
+ * quels, et seuls les états et les transitions du plus petit sont renumérotés
+ * puis ajoutés. Replier n automates avec cette fonction coûte donc de l'ordre
+ * de la taille totale des automates, et non n fois cette taille.
+ *
+ * Les numéros des états de l'un des deux automates peuvent être translatés,
+ * comme pour creer_union_des_automates().
+ *
+ * @param destination L'automate qui reçoit l'union.
+ * @param source L'automate à ajouter. Sa mémoire est libérée.
+ */ 
+void fusionner_automates( Automate * destination, Automate * source );
+
 /**
  * @brief @todo Renvoie l'automate miroir d'un automate.
  *
@@ -448,4 +875,27 @@ Automate * creer_union_des_automates(
  */ 
 Automate *miroir( const Automate * automate);
 
+/**
+ * @brief Renvoie 1 si les deux automates déterministes passés en paramètre
+ *        reconnaissent le même langage, et 0 sinon.
+ *
+ * Les deux automates doivent être déterministes : au plus un état initial, et
+ * au plus un état d'arrivée pour chaque couple (état, lettre). Ils peuvent
+ * être incomplets, une transition absente menant implicitement dans un état
+ * puits non final.
+ *
+ * La fonction utilise l'algorithme de Hopcroft et Karp : les états des deux 
+ * automates sont regroupés dans une structure union-find (avec compression 
+ * de chemins) en partant du couple des états initiaux, et seuls les couples 
+ * d'états accessibles sont explorés. Le coût est quasi-linéaire en la taille 
+ * des automates, sans minimisation préalable.
+ *
+ * @param automate_1 Le premier automate.
+ * @param automate_2 Le deuxième automate.
+ * @return 1 ou 0.
+ */
+int les_automates_deterministes_sont_equivalents(
+	const Automate * automate_1, const Automate * automate_2
+);
+
 #endif
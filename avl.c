@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "avl.h"
+#include "outils.h"
 
 /* Creates and returns a new table
    with comparison function |compare| using parameter |param|
@@ -52,18 +53,64 @@ avl_create (avl_comparison_func *compare, void *param,
   tree->avl_alloc = allocator;
   tree->avl_count = 0;
   tree->avl_generation = 0;
+  tree->avl_value_size = 0;
 
   return tree;
 }
 
+/* Makes each node of the empty |tree| carry |size| bytes of value storage,
+   allocated with the node itself and pointed to by its |avl_value|.
+   New nodes get zeroed storage.
+   Values given to avl_build_sorted() are then pointers to the bytes
+   to copy into the nodes,
+   and avl_copy() copies the storage byte by byte. */
+void
+avl_set_value_size (struct avl_table *tree, size_t size)
+{
+  assert (tree != NULL && tree->avl_count == 0);
+  tree->avl_value_size = size;
+}
+
+/* Allocates a node of |tree|, with its value storage if any.
+   Leaves the node uninitialized, except for |avl_value|:
+   null, or pointing to the zeroed storage.
+   Returns |NULL| in case of memory allocation failure. */
+static struct avl_node *
+new_node (struct avl_table *tree)
+{
+  struct avl_node *n =
+    tree->avl_alloc->libavl_malloc (tree->avl_alloc,
+                                    sizeof *n + tree->avl_value_size);
+  if (n == NULL)
+    return NULL;
+  if (tree->avl_value_size != 0)
+    {
+      n->avl_value = n + 1;
+      memset (n->avl_value, 0, tree->avl_value_size);
+    }
+  else
+    n->avl_value = NULL;
+  return n;
+}
+
 /* Search |tree| for an item matching |item|, and return it if found.
    Otherwise return |NULL|. */
 void *
 avl_find (const struct avl_table *tree, const void *item)
+{
+  const struct avl_node *p = avl_find_node (tree, item);
+  return p != NULL ? p->avl_data : NULL;
+}
+
+/* Search |tree| for an item matching |item|, and return its node if found.
+   Otherwise return |NULL|.
+   Unlike |avl_find()|, null items are allowed. */
+const struct avl_node *
+avl_find_node (const struct avl_table *tree, const void *item)
 {
   const struct avl_node *p;
 
-  assert (tree != NULL && item != NULL);
+  assert (tree != NULL);
   for (p = tree->avl_root; p != NULL; )
     {
       int cmp = tree->avl_compare (item, p->avl_data, tree->avl_param);
@@ -73,7 +120,7 @@ avl_find (const struct avl_table *tree, const void *item)
       else if (cmp > 0)
         p = p->avl_link[1];
       else /* |cmp == 0| */
-        return p->avl_data;
+        return p;
     }
 
   return NULL;
@@ -86,49 +133,92 @@ avl_find (const struct avl_table *tree, const void *item)
 void **
 avl_probe (struct avl_table *tree, void *item)
 {
-  struct avl_node *y, *z; /* Top node to update balance factor, and parent. */
+  struct avl_node *n;
+
+  assert (item != NULL);
+  n = avl_probe_node (tree, item);
+  return n != NULL ? &n->avl_data : NULL;
+}
+
+/* Inserts |item| into |tree| and returns the node holding it,
+   whose |avl_value| is null (or points to zeroed storage).
+   If a duplicate item is found in the tree,
+   returns the duplicate's node without inserting |item|.
+   Returns |NULL| in case of memory allocation failure.
+   Null items are allowed. */
+struct avl_node *
+avl_probe_node (struct avl_table *tree, void *item)
+{
   struct avl_node *p, *q; /* Iterator, and parent. */
-  struct avl_node *n;     /* Newly inserted node. */
-  struct avl_node *w;     /* New root of rebalanced subtree. */
   int dir;                /* Direction to descend. */
 
-  unsigned char da[AVL_MAX_HEIGHT]; /* Cached comparison results. */
-  int k = 0;              /* Number of cached results. */
-
-  assert (tree != NULL && item != NULL);
+  assert (tree != NULL);
 
-  z = (struct avl_node *) &tree->avl_root;
-  y = tree->avl_root;
   dir = 0;
-  for (q = z, p = y; p != NULL; q = p, p = p->avl_link[dir])
+  for (q = NULL, p = tree->avl_root; p != NULL; q = p, p = p->avl_link[dir])
     {
       int cmp = tree->avl_compare (item, p->avl_data, tree->avl_param);
       if (cmp == 0)
-        return &p->avl_data;
-
-      if (p->avl_balance != 0)
-        z = q, y = p, k = 0;
-      da[k++] = dir = cmp > 0;
+        return p;
+      dir = cmp > 0;
     }
 
-  n = q->avl_link[dir] =
-    tree->avl_alloc->libavl_malloc (tree->avl_alloc, sizeof *n);
+  return avl_attach_node (tree, q, dir, item);
+}
+
+/* Inserts |item| into |tree| as the |dir| child of |q|,
+   which must be a null link reached by descending from the root
+   (|q| is null when |tree| is empty),
+   rebalances the tree and returns the new node,
+   whose |avl_value| is null (or points to zeroed storage).
+   Lets callers that compare items themselves
+   share the rebalancing code of avl_probe_node().
+   Returns |NULL| in case of memory allocation failure. */
+struct avl_node *
+avl_attach_node (struct avl_table *tree, struct avl_node *q, int dir,
+                 void *item)
+{
+  struct avl_node *y;     /* Top node to update balance factor. */
+  struct avl_node *z;     /* Parent of |y|, or null if |y| is the root. */
+  struct avl_node *p, *c; /* Iterator, and child on the path to |n|. */
+  struct avl_node *n;     /* Newly inserted node. */
+  struct avl_node *w;     /* New root of rebalanced subtree. */
+
+  assert (tree != NULL);
+  assert (q == NULL ? tree->avl_root == NULL : q->avl_link[dir] == NULL);
+
+  n = new_node (tree);
   if (n == NULL)
     return NULL;
 
   tree->avl_count++;
   n->avl_data = item;
   n->avl_link[0] = n->avl_link[1] = NULL;
+  n->avl_parent = q;
   n->avl_balance = 0;
-  if (y == NULL)
-    return &n->avl_data;
+  if (q == NULL)
+    {
+      tree->avl_root = n;
+      return n;
+    }
+  q->avl_link[dir] = n;
 
-  for (p = y, k = 0; p != n; p = p->avl_link[da[k]], k++)
-    if (da[k] == 0)
-      p->avl_balance--;
-    else
-      p->avl_balance++;
+  /* |y| is the lowest ancestor of |n| with a nonzero balance factor,
+     or the root if there is none. */
+  for (y = q; y->avl_balance == 0 && y->avl_parent != NULL; y = y->avl_parent)
+    ;
+
+  for (c = n, p = q; ; c = p, p = p->avl_parent)
+    {
+      if (p->avl_link[0] == c)
+        p->avl_balance--;
+      else
+        p->avl_balance++;
+      if (p == y)
+        break;
+    }
 
+  z = y->avl_parent;
   if (y->avl_balance == -2)
     {
       struct avl_node *x = y->avl_link[0];
@@ -138,6 +228,10 @@ avl_probe (struct avl_table *tree, void *item)
           y->avl_link[0] = x->avl_link[1];
           x->avl_link[1] = y;
           x->avl_balance = y->avl_balance = 0;
+          x->avl_parent = y->avl_parent;
+          y->avl_parent = x;
+          if (y->avl_link[0] != NULL)
+            y->avl_link[0]->avl_parent = y;
         }
       else
         {
@@ -154,6 +248,12 @@ avl_probe (struct avl_table *tree, void *item)
           else /* |w->avl_balance == +1| */
             x->avl_balance = -1, y->avl_balance = 0;
           w->avl_balance = 0;
+          w->avl_parent = y->avl_parent;
+          x->avl_parent = y->avl_parent = w;
+          if (x->avl_link[1] != NULL)
+            x->avl_link[1]->avl_parent = x;
+          if (y->avl_link[0] != NULL)
+            y->avl_link[0]->avl_parent = y;
         }
     }
   else if (y->avl_balance == +2)
@@ -165,6 +265,10 @@ avl_probe (struct avl_table *tree, void *item)
           y->avl_link[1] = x->avl_link[0];
           x->avl_link[0] = y;
           x->avl_balance = y->avl_balance = 0;
+          x->avl_parent = y->avl_parent;
+          y->avl_parent = x;
+          if (y->avl_link[1] != NULL)
+            y->avl_link[1]->avl_parent = y;
         }
       else
         {
@@ -181,14 +285,23 @@ avl_probe (struct avl_table *tree, void *item)
           else /* |w->avl_balance == -1| */
             x->avl_balance = +1, y->avl_balance = 0;
           w->avl_balance = 0;
+          w->avl_parent = y->avl_parent;
+          x->avl_parent = y->avl_parent = w;
+          if (x->avl_link[0] != NULL)
+            x->avl_link[0]->avl_parent = x;
+          if (y->avl_link[1] != NULL)
+            y->avl_link[1]->avl_parent = y;
         }
     }
   else
-    return &n->avl_data;
-  z->avl_link[y != z->avl_link[0]] = w;
+    return n;
+  if (z == NULL)
+    tree->avl_root = w;
+  else
+    z->avl_link[y != z->avl_link[0]] = w;
 
   tree->avl_generation++;
-  return &n->avl_data;
+  return n;
 }
 
 /* Inserts |item| into |table|.
@@ -224,6 +337,21 @@ avl_replace (struct avl_table *table, void *item)
    Returns a null pointer if no matching item found. */
 void *
 avl_delete (struct avl_table *tree, const void *item)
+{
+  void *data;
+
+  assert (item != NULL);
+  return avl_remove (tree, item, &data, NULL) ? data : NULL;
+}
+
+/* Deletes from |tree| an item matching |item|.
+   Returns nonzero if one was found, in which case the deleted item and
+   its value are stored in |*data| and, if |value| is non-null, |*value|.
+   Returns zero if no matching item found.
+   Null items are allowed. */
+int
+avl_remove (struct avl_table *tree, const void *item,
+            void **data, void **value)
 {
   /* Stack of nodes. */
   struct avl_node *pa[AVL_MAX_HEIGHT]; /* Nodes. */
@@ -233,7 +361,7 @@ avl_delete (struct avl_table *tree, const void *item)
   struct avl_node *p;   /* Traverses tree to find node to delete. */
   int cmp;              /* Result of comparison between |item| and |p|. */
 
-  assert (tree != NULL && item != NULL);
+  assert (tree != NULL && data != NULL);
 
   k = 0;
   p = (struct avl_node *) &tree->avl_root;
@@ -247,12 +375,18 @@ avl_delete (struct avl_table *tree, const void *item)
 
       p = p->avl_link[dir];
       if (p == NULL)
-        return NULL;
+        return 0;
     }
-  item = p->avl_data;
+  *data = p->avl_data;
+  if (value != NULL)
+    *value = tree->avl_value_size == 0 ? p->avl_value : NULL;
 
   if (p->avl_link[1] == NULL)
-    pa[k - 1]->avl_link[da[k - 1]] = p->avl_link[0];
+    {
+      pa[k - 1]->avl_link[da[k - 1]] = p->avl_link[0];
+      if (p->avl_link[0] != NULL)
+        p->avl_link[0]->avl_parent = p->avl_parent;
+    }
   else
     {
       struct avl_node *r = p->avl_link[1];
@@ -260,6 +394,9 @@ avl_delete (struct avl_table *tree, const void *item)
         {
           r->avl_link[0] = p->avl_link[0];
           r->avl_balance = p->avl_balance;
+          r->avl_parent = p->avl_parent;
+          if (r->avl_link[0] != NULL)
+            r->avl_link[0]->avl_parent = r;
           pa[k - 1]->avl_link[da[k - 1]] = r;
           da[k] = 1;
           pa[k++] = r;
@@ -284,6 +421,12 @@ avl_delete (struct avl_table *tree, const void *item)
           r->avl_link[0] = s->avl_link[1];
           s->avl_link[1] = p->avl_link[1];
           s->avl_balance = p->avl_balance;
+          s->avl_parent = p->avl_parent;
+          s->avl_link[1]->avl_parent = s;
+          if (s->avl_link[0] != NULL)
+            s->avl_link[0]->avl_parent = s;
+          if (r->avl_link[0] != NULL)
+            r->avl_link[0]->avl_parent = r;
 
           pa[j - 1]->avl_link[da[j - 1]] = s;
           da[j] = 1;
@@ -322,12 +465,22 @@ avl_delete (struct avl_table *tree, const void *item)
                   else /* |w->avl_balance == -1| */
                     x->avl_balance = +1, y->avl_balance = 0;
                   w->avl_balance = 0;
+                  w->avl_parent = y->avl_parent;
+                  x->avl_parent = y->avl_parent = w;
+                  if (x->avl_link[0] != NULL)
+                    x->avl_link[0]->avl_parent = x;
+                  if (y->avl_link[1] != NULL)
+                    y->avl_link[1]->avl_parent = y;
                   pa[k - 1]->avl_link[da[k - 1]] = w;
                 }
               else
                 {
                   y->avl_link[1] = x->avl_link[0];
                   x->avl_link[0] = y;
+                  x->avl_parent = y->avl_parent;
+                  y->avl_parent = x;
+                  if (y->avl_link[1] != NULL)
+                    y->avl_link[1]->avl_parent = y;
                   pa[k - 1]->avl_link[da[k - 1]] = x;
                   if (x->avl_balance == 0)
                     {
@@ -364,12 +517,22 @@ avl_delete (struct avl_table *tree, const void *item)
                   else /* |w->avl_balance == +1| */
                     x->avl_balance = -1, y->avl_balance = 0;
                   w->avl_balance = 0;
+                  w->avl_parent = y->avl_parent;
+                  x->avl_parent = y->avl_parent = w;
+                  if (x->avl_link[1] != NULL)
+                    x->avl_link[1]->avl_parent = x;
+                  if (y->avl_link[0] != NULL)
+                    y->avl_link[0]->avl_parent = y;
                   pa[k - 1]->avl_link[da[k - 1]] = w;
                 }
               else
                 {
                   y->avl_link[0] = x->avl_link[1];
                   x->avl_link[1] = y;
+                  x->avl_parent = y->avl_parent;
+                  y->avl_parent = x;
+                  if (y->avl_link[0] != NULL)
+                    y->avl_link[0]->avl_parent = y;
                   pa[k - 1]->avl_link[da[k - 1]] = x;
                   if (x->avl_balance == 0)
                     {
@@ -386,7 +549,7 @@ avl_delete (struct avl_table *tree, const void *item)
 
   tree->avl_count--;
   tree->avl_generation++;
-  return (void *) item;
+  return 1;
 }
 
 /* Refreshes the stack of parent pointers in |trav|
@@ -492,7 +655,7 @@ avl_t_find (struct avl_traverser *trav, struct avl_table *tree, void *item)
 {
   struct avl_node *p, *q;
 
-  assert (trav != NULL && tree != NULL && item != NULL);
+  assert (trav != NULL && tree != NULL);
   trav->avl_table = tree;
   trav->avl_height = 0;
   trav->avl_generation = tree->avl_generation;
@@ -738,6 +901,7 @@ avl_copy (const struct avl_table *org, avl_copy_func *copy,
   if (new == NULL)
     return NULL;
   new->avl_count = org->avl_count;
+  new->avl_value_size = org->avl_value_size;
   if (new->avl_count == 0)
     return new;
 
@@ -749,9 +913,7 @@ avl_copy (const struct avl_table *org, avl_copy_func *copy,
         {
           assert (height < 2 * (AVL_MAX_HEIGHT + 1));
 
-          y->avl_link[0] =
-            new->avl_alloc->libavl_malloc (new->avl_alloc,
-                                           sizeof *y->avl_link[0]);
+          y->avl_link[0] = new_node (new);
           if (y->avl_link[0] == NULL)
             {
               if (y != (struct avl_node *) &new->avl_root)
@@ -764,6 +926,8 @@ avl_copy (const struct avl_table *org, avl_copy_func *copy,
               return NULL;
             }
 
+          y->avl_link[0]->avl_parent =
+            y != (struct avl_node *) &new->avl_root ? y : NULL;
           stack[height++] = (struct avl_node *) x;
           stack[height++] = y;
           x = x->avl_link[0];
@@ -774,6 +938,10 @@ avl_copy (const struct avl_table *org, avl_copy_func *copy,
       for (;;)
         {
           y->avl_balance = x->avl_balance;
+          if (new->avl_value_size == 0)
+            y->avl_value = x->avl_value;
+          else
+            memcpy (y->avl_value, x->avl_value, new->avl_value_size);
           if (copy == NULL)
             y->avl_data = x->avl_data;
           else
@@ -789,15 +957,14 @@ avl_copy (const struct avl_table *org, avl_copy_func *copy,
 
           if (x->avl_link[1] != NULL)
             {
-              y->avl_link[1] =
-                new->avl_alloc->libavl_malloc (new->avl_alloc,
-                                               sizeof *y->avl_link[1]);
+              y->avl_link[1] = new_node (new);
               if (y->avl_link[1] == NULL)
                 {
                   copy_error_recovery (stack, height, new, destroy);
                   return NULL;
                 }
 
+              y->avl_link[1]->avl_parent = y;
               x = x->avl_link[1];
               y = y->avl_link[1];
               break;
@@ -814,6 +981,92 @@ avl_copy (const struct avl_table *org, avl_copy_func *copy,
     }
 }
 
+/* Frees the nodes of the subtree rooted at |node|, but not their data. */
+static void
+free_subtree (struct avl_table *tree, struct avl_node *node)
+{
+  if (node == NULL)
+    return;
+  free_subtree (tree, node->avl_link[0]);
+  free_subtree (tree, node->avl_link[1]);
+  tree->avl_alloc->libavl_free (tree->avl_alloc, node);
+}
+
+/* Builds a perfectly balanced subtree holding the |n| items of |items|
+   and stores its height in |*height|.
+   Sets |*error| and returns |NULL| in case of memory allocation failure. */
+static struct avl_node *
+build_sorted (struct avl_table *tree, void **items, void **values, size_t n,
+              int *height, int *error)
+{
+  struct avl_node *node;
+  int left, right;
+  size_t mid = n / 2;
+
+  *height = 0;
+  if (n == 0)
+    return NULL;
+
+  node = new_node (tree);
+  if (node == NULL)
+    {
+      *error = 1;
+      return NULL;
+    }
+  node->avl_data = items[mid];
+  if (values != NULL && tree->avl_value_size == 0)
+    node->avl_value = values[mid];
+  else if (values != NULL && values[mid] != NULL)
+    memcpy (node->avl_value, values[mid], tree->avl_value_size);
+  node->avl_link[0] = build_sorted (tree, items, values, mid, &left, error);
+  node->avl_link[1] = build_sorted (tree, items + mid + 1,
+                                    values != NULL ? values + mid + 1 : NULL,
+                                    n - mid - 1, &right, error);
+  if (*error)
+    {
+      free_subtree (tree, node->avl_link[0]);
+      free_subtree (tree, node->avl_link[1]);
+      tree->avl_alloc->libavl_free (tree->avl_alloc, node);
+      return NULL;
+    }
+  if (node->avl_link[0] != NULL)
+    node->avl_link[0]->avl_parent = node;
+  if (node->avl_link[1] != NULL)
+    node->avl_link[1]->avl_parent = node;
+  node->avl_balance = right - left;
+  *height = 1 + (left > right ? left : right);
+  return node;
+}
+
+/* Fills the empty |tree| with the |n| items of |items|,
+   which must be sorted in strictly increasing order
+   according to |tree|'s comparison function.
+   The tree is built bottom-up in linear time, without any comparison.
+   If |values| is non-null, |values[i]| becomes the value of |items[i]|,
+   or, if the nodes carry value storage, points to the bytes to copy
+   into the storage of |items[i]| (null leaves it zeroed).
+   Returns nonzero if successful,
+   or zero in case of memory allocation failure,
+   in which case |tree| is left empty. */
+int
+avl_build_sorted (struct avl_table *tree, void **items, void **values,
+                  size_t n)
+{
+  int height, error = 0;
+
+  assert (tree != NULL && tree->avl_count == 0);
+  assert (n == 0 || items != NULL);
+
+  tree->avl_root = build_sorted (tree, items, values, n, &height, &error);
+  if (error)
+    return 0;
+  if (tree->avl_root != NULL)
+    tree->avl_root->avl_parent = NULL;
+  tree->avl_count = n;
+  tree->avl_generation++;
+  return 1;
+}
+
 /* Frees storage allocated for |tree|.
    If |destroy != NULL|, applies it to each data item in inorder. */
 void
@@ -841,13 +1094,14 @@ avl_destroy (struct avl_table *tree, avl_item_func *destroy)
   tree->avl_alloc->libavl_free (tree->avl_alloc, tree);
 }
 
-/* Allocates |size| bytes of space using |malloc()|.
-   Returns a null pointer if allocation fails. */
+/* Allocates |size| bytes of space using |xmalloc()|, so that tree nodes
+   are seen by the allocation instrumentation (see outils.h).
+   Never returns a null pointer: |xmalloc()| aborts if allocation fails. */
 void *
 avl_malloc (struct libavl_allocator *allocator, size_t size)
 {
   assert (allocator != NULL && size > 0);
-  return malloc (size);
+  return xmalloc (size);
 }
 
 /* Frees |block|. */
@@ -855,10 +1109,10 @@ void
 avl_free (struct libavl_allocator *allocator, void *block)
 {
   assert (allocator != NULL && block != NULL);
-  free (block);
+  xfree (block);
 }
 
-/* Default memory allocator that uses |malloc()| and |free()|. */
+/* Default memory allocator that uses |xmalloc()| and |xfree()|. */
 struct libavl_allocator avl_allocator_default =
   {
     avl_malloc,
@@ -886,6 +1140,73 @@ void *
   return p;
 }
 
+/* Returns the node holding the least item in |tree|,
+   or a null pointer if |tree| is empty. */
+const struct avl_node *
+avl_node_first (const struct avl_table *tree)
+{
+  const struct avl_node *x = tree->avl_root;
+  if (x != NULL)
+    while (x->avl_link[0] != NULL)
+      x = x->avl_link[0];
+  return x;
+}
+
+/* Returns the node holding the greatest item in |tree|,
+   or a null pointer if |tree| is empty. */
+const struct avl_node *
+avl_node_last (const struct avl_table *tree)
+{
+  const struct avl_node *x = tree->avl_root;
+  if (x != NULL)
+    while (x->avl_link[1] != NULL)
+      x = x->avl_link[1];
+  return x;
+}
+
+/* Returns the in-order successor of |node|,
+   or a null pointer if |node| holds the greatest item.
+   Climbs parent pointers, so no traversal stack is needed. */
+const struct avl_node *
+avl_node_next (const struct avl_node *node)
+{
+  const struct avl_node *q;
+
+  assert (node != NULL);
+  if (node->avl_link[1] != NULL)
+    {
+      node = node->avl_link[1];
+      while (node->avl_link[0] != NULL)
+        node = node->avl_link[0];
+      return node;
+    }
+  for (q = node->avl_parent; q != NULL && node == q->avl_link[1];
+       node = q, q = q->avl_parent)
+    ;
+  return q;
+}
+
+/* Returns the in-order predecessor of |node|,
+   or a null pointer if |node| holds the least item. */
+const struct avl_node *
+avl_node_prev (const struct avl_node *node)
+{
+  const struct avl_node *q;
+
+  assert (node != NULL);
+  if (node->avl_link[0] != NULL)
+    {
+      node = node->avl_link[0];
+      while (node->avl_link[1] != NULL)
+        node = node->avl_link[1];
+      return node;
+    }
+  for (q = node->avl_parent; q != NULL && node == q->avl_link[0];
+       node = q, q = q->avl_parent)
+    ;
+  return q;
+}
+
 int avl_t_is_null(struct avl_traverser * t){
 	return t->avl_node == NULL;
 }
@@ -61,13 +61,19 @@ struct avl_table
     struct libavl_allocator *avl_alloc; /* Memory allocator. */
     size_t avl_count;                   /* Number of items in tree. */
     unsigned long avl_generation;       /* Generation number. */
+    size_t avl_value_size;              /* Bytes of value storage in nodes. */
   };
 
-/* An AVL tree node. */
+/* An AVL tree node.
+   If the tree's |avl_value_size| is nonzero, each node is allocated with
+   that many bytes of storage right after it, and |avl_value| points to
+   that storage (see avl_set_value_size()). */
 struct avl_node
   {
     struct avl_node *avl_link[2];  /* Subtrees. */
+    struct avl_node *avl_parent;   /* Parent node, |NULL| for the root. */
     void *avl_data;                /* Pointer to data. */
+    void *avl_value;               /* Value associated with |avl_data|. */
     signed char avl_balance;       /* Balance factor. */
   };
 
@@ -88,11 +94,18 @@ struct avl_table *avl_create (avl_comparison_func *, void *,
 struct avl_table *avl_copy (const struct avl_table *, avl_copy_func *,
                             avl_item_func *, struct libavl_allocator *);
 void avl_destroy (struct avl_table *, avl_item_func *);
+int avl_build_sorted (struct avl_table *, void **, void **, size_t);
+void avl_set_value_size (struct avl_table *, size_t);
 void **avl_probe (struct avl_table *, void *);
+struct avl_node *avl_probe_node (struct avl_table *, void *);
+struct avl_node *avl_attach_node (struct avl_table *, struct avl_node *,
+                                  int, void *);
 void *avl_insert (struct avl_table *, void *);
 void *avl_replace (struct avl_table *, void *);
 void *avl_delete (struct avl_table *, const void *);
+int avl_remove (struct avl_table *, const void *, void **, void **);
 void *avl_find (const struct avl_table *, const void *);
+const struct avl_node *avl_find_node (const struct avl_table *, const void *);
 void avl_assert_insert (struct avl_table *, void *);
 void *avl_assert_delete (struct avl_table *, void *);
 
@@ -111,4 +124,10 @@ void *avl_t_cur (struct avl_traverser *);
 void *avl_t_replace (struct avl_traverser *, void *);
 int avl_t_is_null(struct avl_traverser *);
 
+/* Stackless node functions, relying on parent pointers. */
+const struct avl_node *avl_node_first (const struct avl_table *);
+const struct avl_node *avl_node_last (const struct avl_table *);
+const struct avl_node *avl_node_next (const struct avl_node *);
+const struct avl_node *avl_node_prev (const struct avl_node *);
+
 #endif /* avl.h */
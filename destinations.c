@@ -0,0 +1,185 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "destinations.h"
+#include "outils.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void initialiser_destinations( Destinations * destinations ){
+	destinations->nb = 0;
+	destinations->capacite = 0;
+}
+
+void vider_destinations( Destinations * destinations ){
+	if( destinations->capacite ){
+		xfree( destinations->etats.tas );
+	}
+	initialiser_destinations( destinations );
+}
+
+void detacher_destinations( Destinations * destinations ){
+	if( destinations->capacite ){
+		int * tas = xmalloc( destinations->capacite * sizeof(int) );
+		memcpy( tas, destinations->etats.tas, destinations->nb * sizeof(int) );
+		destinations->etats.tas = tas;
+	}
+}
+
+Destinations * creer_destinations(){
+	Destinations * res = xmalloc( sizeof(Destinations) );
+	initialiser_destinations( res );
+	return res;
+}
+
+void liberer_destinations( Destinations * destinations ){
+	vider_destinations( destinations );
+	xfree( destinations );
+}
+
+Destinations * copier_destinations( const Destinations * destinations ){
+	Destinations * res = xmalloc( sizeof(Destinations) );
+	*res = *destinations;
+	detacher_destinations( res );
+	return res;
+}
+
+/*
+ * Garantit que l'ensemble peut contenir 'n' états. Les états quittent la
+ * structure dès qu'ils n'y tiennent plus.
+ */
+void reserver_destinations( Destinations * destinations, int n ){
+	if( destinations->capacite == 0 ){
+		if( n <= NB_DESTINATIONS_EN_LIGNE ) return;
+		int capacite = 2 * NB_DESTINATIONS_EN_LIGNE;
+		while( capacite < n ){
+			capacite *= 2;
+		}
+		int * tas = xmalloc( capacite * sizeof(int) );
+		memcpy( tas, destinations->etats.en_ligne, destinations->nb * sizeof(int) );
+		destinations->etats.tas = tas;
+		destinations->capacite = capacite;
+		return;
+	}
+	if( n <= destinations->capacite ) return;
+	int capacite = destinations->capacite;
+	while( capacite < n ){
+		capacite *= 2;
+	}
+	destinations->etats.tas = xrealloc( 
+		destinations->etats.tas, capacite * sizeof(int) 
+	);
+	destinations->capacite = capacite;
+}
+
+/*
+ * Renvoie la position du premier état supérieur ou égal à 'etat'.
+ */
+int position_destination( const Destinations * destinations, int etat ){
+	const int * etats = etats_destinations( destinations );
+	int debut = 0;
+	int fin = destinations->nb;
+	while( debut < fin ){
+		int milieu = debut + ( fin - debut ) / 2;
+		if( etats[milieu] < etat ){
+			debut = milieu + 1;
+		}else{
+			fin = milieu;
+		}
+	}
+	return debut;
+}
+
+int ajouter_destination( Destinations * destinations, int etat ){
+	int i = position_destination( destinations, etat );
+	if( 
+		i < destinations->nb && etats_destinations( destinations )[i] == etat 
+	){
+		return 0;
+	}
+	reserver_destinations( destinations, destinations->nb + 1 );
+	int * etats = (int *) etats_destinations( destinations );
+	memmove( &etats[i+1], &etats[i], ( destinations->nb - i ) * sizeof(int) );
+	etats[i] = etat;
+	destinations->nb++;
+	return 1;
+}
+
+void ajouter_destinations_triees(
+	Destinations * destinations, const int * etats, int n
+){
+	int i;
+	if( destinations->nb != 0 ){
+		for( i=0; i<n; i++ ){
+			ajouter_destination( destinations, etats[i] );
+		}
+		return;
+	}
+	if( n <= 0 ) return;
+	reserver_destinations( destinations, n );
+	memcpy( (int *) etats_destinations( destinations ), etats, n * sizeof(int) );
+	destinations->nb = n;
+}
+
+int contient_destination( const Destinations * destinations, int etat ){
+	int i = position_destination( destinations, etat );
+	return i < destinations->nb && etats_destinations( destinations )[i] == etat;
+}
+
+int comparer_destinations( const Destinations * d1, const Destinations * d2 ){
+	const int * etats1 = etats_destinations( d1 );
+	const int * etats2 = etats_destinations( d2 );
+	int i;
+	for( i=0; i < d1->nb && i < d2->nb; i++ ){
+		if( etats1[i] != etats2[i] ){
+			return etats1[i] < etats2[i] ? -1 : 1;
+		}
+	}
+	if( d1->nb == d2->nb ) return 0;
+	return d1->nb < d2->nb ? -1 : 1;
+}
+
+void ajouter_destinations_a_ensemble(
+	Ensemble * ensemble, const Destinations * destinations
+){
+	const int * etats = etats_destinations( destinations );
+	int i;
+	for( i=0; i<destinations->nb; i++ ){
+		ajouter_element( ensemble, etats[i] );
+	}
+}
+
+void print_destinations( const Destinations * destinations ){
+	const int * etats = etats_destinations( destinations );
+	int i;
+	printf( "{" );
+	for( i=0; i < destinations->nb; i++ ){
+		printf( "%d, ", etats[i] );
+	}
+	printf( "}" );
+}
+
+void destinations_memoire( const Destinations * destinations, Memoire * memoire ){
+	if( destinations->capacite ){
+		compter_memoire( memoire, 1, destinations->capacite * sizeof(int) );
+	}
+}
@@ -0,0 +1,145 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef __DESTINATIONS_H__
+#define __DESTINATIONS_H__
+
+#include "ensemble.h"
+
+/*
+ * Nombre d'états d'arrivée rangés dans la structure elle-même, sans 
+ * allocation supplémentaire.
+ */
+#define NB_DESTINATIONS_EN_LIGNE 2
+
+/*
+ * Les états d'arrivée d'une transition (origine, lettre) : un tableau trié
+ * d'états, sans doublons.
+ *
+ * Dans la plupart des automates, une transition n'a qu'un ou deux états 
+ * d'arrivée. Jusqu'à NB_DESTINATIONS_EN_LIGNE états, ils sont rangés dans la
+ * structure ; au-delà, ils sont déplacés dans un tableau alloué, agrandi par 
+ * doublement.
+ */
+typedef struct Destinations {
+	int nb;
+	// 0 tant que les états sont rangés dans 'en_ligne', taille de 'tas' sinon
+	int capacite;
+	union {
+		int en_ligne[NB_DESTINATIONS_EN_LIGNE];
+		int * tas;
+	} etats;
+} Destinations;
+
+/*
+ * Renvoie un ensemble de destinations vide.
+ */
+Destinations * creer_destinations();
+
+/*
+ * Libère un ensemble de destinations.
+ */
+void liberer_destinations( Destinations * destinations );
+
+/*
+ * Renvoie une copie de l'ensemble de destinations.
+ */
+Destinations * copier_destinations( const Destinations * destinations );
+
+/*
+ * Pour des destinations rangées dans une autre structure (par exemple dans 
+ * les noeuds d'une table, voir creer_table_valeurs_en_ligne()) : 
+ * initialiser_destinations() en fait un ensemble vide (une structure remplie
+ * de zéros l'est déjà), vider_destinations() libère le tableau alloué, et 
+ * detacher_destinations() donne un tableau alloué à elle à une structure 
+ * recopiée octet par octet.
+ */
+void initialiser_destinations( Destinations * destinations );
+void vider_destinations( Destinations * destinations );
+void detacher_destinations( Destinations * destinations );
+
+/*
+ * Ajoute un état à l'ensemble des destinations.
+ * Renvoie 1 si l'état a été ajouté, 0 s'il y était déjà.
+ */
+int ajouter_destination( Destinations * destinations, int etat );
+
+/*
+ * Ajoute les n états du tableau 'etats', qui doit être trié dans l'ordre 
+ * strictement croissant. Si l'ensemble est vide, le tableau est recopié en 
+ * une fois ; sinon les états sont ajoutés un par un.
+ */
+void ajouter_destinations_triees(
+	Destinations * destinations, const int * etats, int n
+);
+
+/*
+ * Renvoie 1 si l'état est une destination, 0 sinon (recherche 
+ * dichotomique).
+ */
+int contient_destination( const Destinations * destinations, int etat );
+
+/*
+ * Compare deux ensembles de destinations dans l'ordre lexicographique, comme
+ * comparer_ensemble().
+ */
+int comparer_destinations( const Destinations * d1, const Destinations * d2 );
+
+/*
+ * Ajoute toutes les destinations à l'ensemble.
+ */
+void ajouter_destinations_a_ensemble(
+	Ensemble * ensemble, const Destinations * destinations
+);
+
+/*
+ * Affiche les destinations, dans le même format que print_ensemble().
+ */
+void print_destinations( const Destinations * destinations );
+
+/*
+ * Ajoute à 'memoire' la mémoire allouée par les destinations : le tableau 
+ * alloué si les états ne tiennent plus dans la structure. La structure 
+ * elle-même est comptée avec ce qui la contient.
+ */
+void destinations_memoire( const Destinations * destinations, Memoire * memoire );
+
+/*
+ * Renvoie le nombre de destinations.
+ */
+static inline int taille_destinations( const Destinations * destinations ){
+	return destinations->nb;
+}
+
+/*
+ * Renvoie le tableau trié des destinations, de taille 
+ * taille_destinations(). Le tableau est invalidé par tout ajout.
+ */
+static inline const int * etats_destinations( 
+	const Destinations * destinations 
+){
+	return destinations->capacite ? 
+		destinations->etats.tas : destinations->etats.en_ligne;
+}
+
+#endif
@@ -0,0 +1,604 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "determinisation.h"
+#include "interneur.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * Tableaux d'entiers qui grandissent au fil de la construction.
+ */
+typedef struct {
+	int * elements;
+	int taille;
+	int capacite;
+} Tableau_entiers;
+
+void ajouter_tableau_entiers( Tableau_entiers * tableau, int element ){
+	if( tableau->taille == tableau->capacite ){
+		tableau->capacite = tableau->capacite ? 2 * tableau->capacite : 64;
+		tableau->elements = xrealloc( 
+			tableau->elements, tableau->capacite * sizeof(int) 
+		);
+	}
+	tableau->elements[ tableau->taille++ ] = element;
+}
+
+void liberer_tableau_entiers( Tableau_entiers * tableau ){
+	if( tableau->elements ){
+		xfree( tableau->elements );
+	}
+}
+
+/*
+ * Les transitions de l'automate déterministe, avant leur ajout en masse.
+ */
+typedef struct {
+	Tableau_entiers origines;
+	Tableau_entiers lettres;
+	Tableau_entiers fins;
+	Tableau_entiers finaux;
+} Resultat_determinisation;
+
+void ajouter_transition_resultat( 
+	Resultat_determinisation * resultat, int origine, char lettre, int fin 
+){
+	ajouter_tableau_entiers( &resultat->origines, origine );
+	ajouter_tableau_entiers( &resultat->lettres, lettre );
+	ajouter_tableau_entiers( &resultat->fins, fin );
+}
+
+void liberer_resultat( Resultat_determinisation * resultat ){
+	liberer_tableau_entiers( &resultat->origines );
+	liberer_tableau_entiers( &resultat->lettres );
+	liberer_tableau_entiers( &resultat->fins );
+	liberer_tableau_entiers( &resultat->finaux );
+}
+
+int comparer_entiers_determinisation( const void* a, const void* b ){
+	int e1 = *(const int*) a;
+	int e2 = *(const int*) b;
+	if( e1 < e2 ) return -1;
+	if( e1 > e2 ) return 1;
+	return 0;
+}
+
+/*
+ * Construit l'automate déterministe à nb_etats états à partir des résultats
+ * accumulés (par un ou plusieurs threads).
+ */
+Automate * construire_automate_deterministe( 
+	const Automate * automate, int nb_etats,
+	Resultat_determinisation * resultats, int nb_resultats
+){
+	Automate * res = creer_automate();
+	int i, j;
+
+	intptr_t * elements = xmalloc( ( nb_etats + 1 ) * sizeof(intptr_t) );
+	for( i=0; i<nb_etats; i++ ){
+		elements[i] = i;
+	}
+	ajouter_elements_tries( res->etats, elements, nb_etats );
+	ajouter_elements( res->alphabet, get_alphabet( automate ) );
+	if( nb_etats > 0 ){
+		ajouter_etat_initial( res, 0 );
+	}
+
+	int nb_transitions = 0, nb_finaux = 0;
+	for( j=0; j<nb_resultats; j++ ){
+		nb_transitions += resultats[j].origines.taille;
+		nb_finaux += resultats[j].finaux.taille;
+	}
+	int * origines = xmalloc( ( nb_transitions + 1 ) * sizeof(int) );
+	char * lettres = xmalloc( nb_transitions + 1 );
+	int * fins = xmalloc( ( nb_transitions + 1 ) * sizeof(int) );
+	int * finaux = xmalloc( ( nb_finaux + 1 ) * sizeof(int) );
+	int n = 0, f = 0;
+	for( j=0; j<nb_resultats; j++ ){
+		for( i=0; i<resultats[j].origines.taille; i++, n++ ){
+			origines[n] = resultats[j].origines.elements[i];
+			lettres[n] = (char) resultats[j].lettres.elements[i];
+			fins[n] = resultats[j].fins.elements[i];
+		}
+		for( i=0; i<resultats[j].finaux.taille; i++ ){
+			finaux[f++] = resultats[j].finaux.elements[i];
+		}
+	}
+	ajouter_transitions_en_masse( res, origines, lettres, fins, nb_transitions );
+
+	if( nb_finaux > 0 ){
+		qsort( finaux, nb_finaux, sizeof(int), comparer_entiers_determinisation );
+		for( i=0; i<nb_finaux; i++ ){
+			elements[i] = finaux[i];
+		}
+		ajouter_elements_tries( res->finaux, elements, nb_finaux );
+	}
+
+	xfree( finaux );
+	xfree( fins );
+	xfree( lettres );
+	xfree( origines );
+	xfree( elements );
+	return res;
+}
+
+/*
+ * Renvoie 1 si l'un des états de l'ensemble est final.
+ */
+int contient_un_etat_final( const Automate * automate, const Ensemble * etats ){
+	Ensemble_curseur it;
+	for(
+		it = premier_curseur_ensemble( etats );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
+	){
+		if( est_un_etat_final_de_l_automate( automate, get_element_curseur( it ) ) ){
+			return 1;
+		}
+	}
+	return 0;
+}
+
+Automate * creer_automate_deterministe( const Automate * automate ){
+	// Sans état initial, l'ensemble des états initiaux est vide : ce n'est 
+	// pas un état, et aucun sous-ensemble n'est accessible.
+	if( taille_ensemble( get_initiaux( automate ) ) == 0 ){
+		return creer_automate();
+	}
+
+	// Chaque sous-ensemble découvert est interné : son numéro est celui de
+	// l'état de l'automate déterministe, et les sous-ensembles pas encore 
+	// explorés sont ceux dont le numéro dépasse l'état courant.
+	Interneur * interneur = creer_interneur();
+	Resultat_determinisation resultat;
+	memset( &resultat, 0, sizeof(Resultat_determinisation) );
+
+	Ensemble * initial = creer_ensemble( NULL, NULL, NULL );
+	ajouter_elements( initial, get_initiaux( automate ) );
+	interner_ensemble( interneur, initial, NULL );
+
+	int courant;
+	for( courant = 0; courant < nombre_ensembles_internes( interneur ); courant++ ){
+		const Ensemble * etats = 
+			ensemble_interne_numero( interneur, courant )->ensemble;
+		if( contient_un_etat_final( automate, etats ) ){
+			ajouter_tableau_entiers( &resultat.finaux, courant );
+		}
+		Ensemble_curseur it_lettre;
+		for(
+			it_lettre = premier_curseur_ensemble( get_alphabet( automate ) );
+			! curseur_ensemble_est_vide( it_lettre );
+			it_lettre = curseur_suivant_ensemble( it_lettre )
+		){
+			char lettre = (char) get_element_curseur( it_lettre );
+			Ensemble * suivant = delta( automate, etats, lettre );
+			if( taille_ensemble( suivant ) == 0 ){
+				liberer_ensemble( suivant );
+				continue;
+			}
+			const Ensemble_interne * fin = 
+				interner_ensemble( interneur, suivant, NULL );
+			ajouter_transition_resultat( &resultat, courant, lettre, fin->numero );
+		}
+	}
+
+	Automate * res = construire_automate_deterministe( 
+		automate, nombre_ensembles_internes( interneur ), &resultat, 1 
+	);
+	liberer_resultat( &resultat );
+	liberer_interneur( interneur );
+	return res;
+}
+
+/*
+ *=============================================================================
+ *                        Version parallèle
+ *=============================================================================
+ */
+
+/*
+ * Un sous-ensemble d'états, stocké sous la forme d'un tableau trié.
+ */
+typedef struct Sous_ensemble {
+	uint64_t hash;
+	int id;
+	int taille;
+	struct Sous_ensemble * suivant; // Chaînage dans la table de hachage
+	int etats[];
+} Sous_ensemble;
+
+uint64_t hacher_etats( const int * etats, int taille ){
+	uint64_t hash = 14695981039346656037ULL;
+	int i;
+	for( i=0; i<taille; i++ ){
+		hash ^= (uint32_t) etats[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash ^ ( hash >> 32 );
+}
+
+/*
+ * Table de hachage concurrente des sous-ensembles découverts. Elle est 
+ * découpée en bandes indépendantes, chacune protégée par son verrou : deux
+ * threads ne se bloquent que s'ils cherchent dans la même bande.
+ */
+#define NB_BANDES 64
+
+typedef struct {
+	pthread_mutex_t verrou;
+	Sous_ensemble ** alveoles;
+	int nb_alveoles;
+	int nb_elements;
+} Bande;
+
+typedef struct {
+	Bande bandes[NB_BANDES];
+	atomic_int prochain_id;
+} Table_sous_ensembles;
+
+void initialiser_table_sous_ensembles( Table_sous_ensembles * table ){
+	int i;
+	for( i=0; i<NB_BANDES; i++ ){
+		pthread_mutex_init( &table->bandes[i].verrou, NULL );
+		table->bandes[i].nb_alveoles = 16;
+		table->bandes[i].nb_elements = 0;
+		table->bandes[i].alveoles = xmalloc( 16 * sizeof(Sous_ensemble*) );
+		memset( table->bandes[i].alveoles, 0, 16 * sizeof(Sous_ensemble*) );
+	}
+	atomic_init( &table->prochain_id, 0 );
+}
+
+void liberer_table_sous_ensembles( Table_sous_ensembles * table ){
+	int i, j;
+	for( i=0; i<NB_BANDES; i++ ){
+		Bande * bande = &table->bandes[i];
+		for( j=0; j<bande->nb_alveoles; j++ ){
+			Sous_ensemble * s = bande->alveoles[j];
+			while( s ){
+				Sous_ensemble * suivant = s->suivant;
+				xfree( s );
+				s = suivant;
+			}
+		}
+		xfree( bande->alveoles );
+		pthread_mutex_destroy( &bande->verrou );
+	}
+}
+
+void agrandir_bande( Bande * bande ){
+	int nb_alveoles = 2 * bande->nb_alveoles;
+	Sous_ensemble ** alveoles = xmalloc( nb_alveoles * sizeof(Sous_ensemble*) );
+	memset( alveoles, 0, nb_alveoles * sizeof(Sous_ensemble*) );
+	int i;
+	for( i=0; i<bande->nb_alveoles; i++ ){
+		Sous_ensemble * s = bande->alveoles[i];
+		while( s ){
+			Sous_ensemble * suivant = s->suivant;
+			int j = ( s->hash / NB_BANDES ) % nb_alveoles;
+			s->suivant = alveoles[j];
+			alveoles[j] = s;
+			s = suivant;
+		}
+	}
+	xfree( bande->alveoles );
+	bande->alveoles = alveoles;
+	bande->nb_alveoles = nb_alveoles;
+}
+
+/*
+ * Renvoie le sous-ensemble de la table égal au tableau trié 'etats'. S'il 
+ * n'existe pas encore, il est créé, reçoit un nouveau numéro, et 
+ * '*nouveau' est mis à 1.
+ */
+Sous_ensemble * interner_sous_ensemble( 
+	Table_sous_ensembles * table, const int * etats, int taille, int * nouveau 
+){
+	uint64_t hash = hacher_etats( etats, taille );
+	Bande * bande = &table->bandes[ hash % NB_BANDES ];
+	pthread_mutex_lock( &bande->verrou );
+	Sous_ensemble * s = bande->alveoles[ ( hash / NB_BANDES ) % bande->nb_alveoles ];
+	while( s ){
+		if( 
+			s->hash == hash && s->taille == taille 
+			&& memcmp( s->etats, etats, taille * sizeof(int) ) == 0
+		){
+			pthread_mutex_unlock( &bande->verrou );
+			*nouveau = 0;
+			return s;
+		}
+		s = s->suivant;
+	}
+	s = xmalloc( sizeof(Sous_ensemble) + taille * sizeof(int) );
+	s->hash = hash;
+	s->taille = taille;
+	memcpy( s->etats, etats, taille * sizeof(int) );
+	s->id = atomic_fetch_add( &table->prochain_id, 1 );
+	if( bande->nb_elements >= 2 * bande->nb_alveoles ){
+		agrandir_bande( bande );
+	}
+	int j = ( hash / NB_BANDES ) % bande->nb_alveoles;
+	s->suivant = bande->alveoles[j];
+	bande->alveoles[j] = s;
+	bande->nb_elements++;
+	pthread_mutex_unlock( &bande->verrou );
+	*nouveau = 1;
+	return s;
+}
+
+/*
+ * File de travail d'un thread. Le thread propriétaire empile et dépile à la
+ * fin, les autres threads volent au début.
+ */
+typedef struct {
+	pthread_mutex_t verrou;
+	Sous_ensemble ** elements;
+	int debut;
+	int fin;
+	int capacite;
+} File_de_travail;
+
+void empiler_travail( File_de_travail * file, Sous_ensemble * s ){
+	pthread_mutex_lock( &file->verrou );
+	if( file->fin == file->capacite ){
+		if( file->debut > file->capacite / 2 ){
+			memmove( 
+				file->elements, file->elements + file->debut, 
+				( file->fin - file->debut ) * sizeof(Sous_ensemble*) 
+			);
+			file->fin -= file->debut;
+			file->debut = 0;
+		}else{
+			file->capacite *= 2;
+			file->elements = xrealloc( 
+				file->elements, file->capacite * sizeof(Sous_ensemble*) 
+			);
+		}
+	}
+	file->elements[ file->fin++ ] = s;
+	pthread_mutex_unlock( &file->verrou );
+}
+
+Sous_ensemble * depiler_travail( File_de_travail * file ){
+	Sous_ensemble * s = NULL;
+	pthread_mutex_lock( &file->verrou );
+	if( file->debut < file->fin ){
+		s = file->elements[ --file->fin ];
+	}
+	pthread_mutex_unlock( &file->verrou );
+	return s;
+}
+
+Sous_ensemble * voler_travail( File_de_travail * file ){
+	Sous_ensemble * s = NULL;
+	pthread_mutex_lock( &file->verrou );
+	if( file->debut < file->fin ){
+		s = file->elements[ file->debut++ ];
+	}
+	pthread_mutex_unlock( &file->verrou );
+	return s;
+}
+
+typedef struct {
+	const Automate * automate;
+	const char * lettres;
+	int nb_lettres;
+	Table_sous_ensembles table;
+	File_de_travail * files;
+	int nb_threads;
+	// Nombre de sous-ensembles découverts mais pas encore explorés
+	atomic_int en_attente;
+} Determinisation_parallele;
+
+typedef struct {
+	Determinisation_parallele * partage;
+	int numero;
+	Resultat_determinisation resultat;
+} Travailleur;
+
+/*
+ * Explore un sous-ensemble : calcule ses successeurs pour chaque lettre, et
+ * ajoute les nouveaux sous-ensembles à la file du thread.
+ */
+void explorer_sous_ensemble( 
+	Travailleur * travailleur, Sous_ensemble * s, Tableau_entiers * tampon 
+){
+	Determinisation_parallele * partage = travailleur->partage;
+	const Automate * automate = partage->automate;
+	int i, k;
+
+	for( i=0; i<s->taille; i++ ){
+		if( est_un_etat_final_de_l_automate( automate, s->etats[i] ) ){
+			ajouter_tableau_entiers( &travailleur->resultat.finaux, s->id );
+			break;
+		}
+	}
+	for( k=0; k<partage->nb_lettres; k++ ){
+		char lettre = partage->lettres[k];
+		tampon->taille = 0;
+		for( i=0; i<s->taille; i++ ){
+			const Destinations * fins = voisins( automate, s->etats[i], lettre );
+			const int * etats = etats_destinations( fins );
+			int j;
+			for( j=0; j<taille_destinations( fins ); j++ ){
+				ajouter_tableau_entiers( tampon, etats[j] );
+			}
+		}
+		if( tampon->taille == 0 ){
+			continue;
+		}
+		qsort( 
+			tampon->elements, tampon->taille, sizeof(int), 
+			comparer_entiers_determinisation 
+		);
+		int taille = 0;
+		for( i=0; i<tampon->taille; i++ ){
+			if( taille == 0 || tampon->elements[taille-1] != tampon->elements[i] ){
+				tampon->elements[taille++] = tampon->elements[i];
+			}
+		}
+		int nouveau;
+		Sous_ensemble * suivant = interner_sous_ensemble( 
+			&partage->table, tampon->elements, taille, &nouveau 
+		);
+		if( nouveau ){
+			atomic_fetch_add( &partage->en_attente, 1 );
+			empiler_travail( &partage->files[ travailleur->numero ], suivant );
+		}
+		ajouter_transition_resultat( 
+			&travailleur->resultat, s->id, lettre, suivant->id 
+		);
+	}
+}
+
+void * travailler( void * data ){
+	Travailleur * travailleur = (Travailleur *) data;
+	Determinisation_parallele * partage = travailleur->partage;
+	Tableau_entiers tampon = { NULL, 0, 0 };
+
+	while( 1 ){
+		Sous_ensemble * s = depiler_travail( 
+			&partage->files[ travailleur->numero ] 
+		);
+		int i;
+		for( i=1; ! s && i<partage->nb_threads; i++ ){
+			s = voler_travail( 
+				&partage->files[ ( travailleur->numero + i ) % partage->nb_threads ] 
+			);
+		}
+		if( s ){
+			explorer_sous_ensemble( travailleur, s, &tampon );
+			atomic_fetch_sub( &partage->en_attente, 1 );
+		}else if( atomic_load( &partage->en_attente ) == 0 ){
+			break;
+		}else{
+			sched_yield();
+		}
+	}
+
+	liberer_tableau_entiers( &tampon );
+	return NULL;
+}
+
+Automate * creer_automate_deterministe_parallele( 
+	const Automate * automate, int nb_threads 
+){
+	if( nb_threads <= 0 ){
+		nb_threads = sysconf( _SC_NPROCESSORS_ONLN );
+		if( nb_threads <= 0 ){
+			nb_threads = 1;
+		}
+	}
+	if( taille_ensemble( get_initiaux( automate ) ) == 0 ){
+		return creer_automate();
+	}
+	int i;
+	Determinisation_parallele partage;
+	partage.automate = automate;
+	partage.nb_threads = nb_threads;
+	initialiser_table_sous_ensembles( &partage.table );
+
+	const Ensemble * alphabet = get_alphabet( automate );
+	char * lettres = xmalloc( taille_ensemble( alphabet ) + 1 );
+	partage.nb_lettres = 0;
+	Ensemble_curseur it;
+	for(
+		it = premier_curseur_ensemble( alphabet );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
+	){
+		lettres[ partage.nb_lettres++ ] = (char) get_element_curseur( it );
+	}
+	partage.lettres = lettres;
+
+	partage.files = xmalloc( nb_threads * sizeof(File_de_travail) );
+	for( i=0; i<nb_threads; i++ ){
+		pthread_mutex_init( &partage.files[i].verrou, NULL );
+		partage.files[i].capacite = 64;
+		partage.files[i].debut = 0;
+		partage.files[i].fin = 0;
+		partage.files[i].elements = xmalloc( 64 * sizeof(Sous_ensemble*) );
+	}
+
+	// L'ensemble des états initiaux reçoit le numéro 0
+	int nb_initiaux = taille_ensemble( get_initiaux( automate ) );
+	int * initiaux = xmalloc( ( nb_initiaux + 1 ) * sizeof(int) );
+	nb_initiaux = 0;
+	for(
+		it = premier_curseur_ensemble( get_initiaux( automate ) );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
+	){
+		initiaux[ nb_initiaux++ ] = get_element_curseur( it );
+	}
+	int nouveau;
+	Sous_ensemble * initial = interner_sous_ensemble( 
+		&partage.table, initiaux, nb_initiaux, &nouveau 
+	);
+	xfree( initiaux );
+	atomic_init( &partage.en_attente, 1 );
+	empiler_travail( &partage.files[0], initial );
+
+	Travailleur * travailleurs = xmalloc( nb_threads * sizeof(Travailleur) );
+	pthread_t * threads = xmalloc( nb_threads * sizeof(pthread_t) );
+	for( i=0; i<nb_threads; i++ ){
+		travailleurs[i].partage = &partage;
+		travailleurs[i].numero = i;
+		memset( &travailleurs[i].resultat, 0, sizeof(Resultat_determinisation) );
+		if( pthread_create( &threads[i], NULL, travailler, &travailleurs[i] ) ){
+			ERREUR( "Impossible de créer un thread" );
+		}
+	}
+	for( i=0; i<nb_threads; i++ ){
+		pthread_join( threads[i], NULL );
+	}
+
+	Resultat_determinisation * resultats = 
+		xmalloc( nb_threads * sizeof(Resultat_determinisation) );
+	for( i=0; i<nb_threads; i++ ){
+		resultats[i] = travailleurs[i].resultat;
+	}
+	Automate * res = construire_automate_deterministe( 
+		automate, atomic_load( &partage.table.prochain_id ), 
+		resultats, nb_threads 
+	);
+
+	for( i=0; i<nb_threads; i++ ){
+		liberer_resultat( &resultats[i] );
+		xfree( partage.files[i].elements );
+		pthread_mutex_destroy( &partage.files[i].verrou );
+	}
+	xfree( resultats );
+	xfree( threads );
+	xfree( travailleurs );
+	xfree( partage.files );
+	xfree( lettres );
+	liberer_table_sous_ensembles( &partage.table );
+	return res;
+}
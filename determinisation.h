@@ -0,0 +1,79 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef __DETERMINISATION_H__
+#define __DETERMINISATION_H__
+
+#include "automate.h"
+
+/**
+ * @brief Crée l'automate déterministe associé à un automate, par la 
+ *        construction des sous-ensembles.
+ *
+ * Seuls les sous-ensembles accessibles sont construits, et l'ensemble vide
+ * n'est pas un état : l'automate obtenu n'est pas forcément complet. Les 
+ * états sont numérotés à partir de 0 dans l'ordre où ils sont découverts
+ * par un parcours en largeur depuis l'ensemble des états initiaux (qui est 
+ * l'état 0), les lettres étant parcourues dans l'ordre croissant. 
+ * L'automate obtenu est donc déjà compacté (voir compacter_automate()).
+ * Si l'automate n'a aucun état initial, l'automate renvoyé n'a aucun état.
+ *
+ * La mémoire de l'automate renvoyé est laissée à la charge de 
+ * l'utilisateur.
+ *
+ * @param automate Un automate.
+ * @return L'automate déterministe.
+ */
+Automate * creer_automate_deterministe( const Automate * automate );
+
+/**
+ * @brief Crée l'automate déterministe associé à un automate, en répartissant
+ *        la construction des sous-ensembles sur plusieurs threads.
+ *
+ * Chaque thread possède une file de sous-ensembles à explorer, dans 
+ * laquelle les autres threads viennent voler du travail quand la leur est 
+ * vide. Les sous-ensembles découverts sont enregistrés dans une table de 
+ * hachage partagée, découpée en bandes protégées chacune par son verrou, et
+ * reçoivent un numéro attribué atomiquement. Chaque thread accumule ses 
+ * transitions dans ses propres tableaux, qui sont ajoutés en masse à la fin.
+ *
+ * L'automate obtenu est le même que celui de creer_automate_deterministe(),
+ * à la numérotation des états près : les numéros dépendent de l'ordre 
+ * d'exécution des threads. Pour obtenir exactement le même automate, il 
+ * suffit d'appeler compacter_automate() sur le résultat.
+ *
+ * L'automate passé en paramètre est seulement lu, et ne doit pas être 
+ * modifié pendant l'appel.
+ *
+ * La mémoire de l'automate renvoyé est laissée à la charge de 
+ * l'utilisateur.
+ *
+ * @param automate Un automate.
+ * @param nb_threads Le nombre de threads à utiliser. S'il est négatif ou 
+ *        nul, le nombre de processeurs disponibles est utilisé.
+ * @return L'automate déterministe.
+ */
+Automate * creer_automate_deterministe_parallele( 
+	const Automate * automate, int nb_threads 
+);
+
+#endif
@@ -24,9 +24,11 @@
 #include "ensemble.h"
 #include "outils.h"
 #include "table.h"
+#include "specialisation.h"
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 
 int* allouer_element( int val ){
@@ -39,33 +41,63 @@ void supprimer_element( int* element ){
 	xfree( element );
 }
 
-void next_iterators( Table_iterateur * it1, Table_iterateur * it2 ){
-	*it1 = iterateur_suivant_table(*it1);
-	*it2 = iterateur_suivant_table(*it2);
+/*
+ * Empreinte d'un élément entier (fonction de mélange « splitmix64 »).
+ */
+uint64_t hash_element( const intptr_t element ){
+	uint64_t x = (uint64_t) element + 0x9E3779B97F4A7C15ULL;
+	x = ( x ^ ( x >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+	x = ( x ^ ( x >> 27 ) ) * 0x94D049BB133111EBULL;
+	return x ^ ( x >> 31 );
+}
+
+/*
+ * Met à jour l'empreinte d'un ensemble d'entiers dont la taille est passée
+ * de 'ancienne_taille' à sa taille actuelle par l'ajout ou le retrait de 
+ * l'élément.
+ */
+void mettre_a_jour_hash( 
+	Ensemble * ensemble, unsigned int ancienne_taille, const intptr_t element 
+){
+	if( 
+		! ensemble->comparer_element 
+		&& taille_table( ensemble->table ) != ancienne_taille 
+	){
+		ensemble->hash ^= hash_element( element );
+	}
+}
+
+void next_iterators( Table_curseur * c1, Table_curseur * c2 ){
+	*c1 = curseur_suivant_table(*c1);
+	*c2 = curseur_suivant_table(*c2);
 }
 
 int comparer_ensemble( const Ensemble* ens1, const Ensemble*  ens2 ){
-	Table_iterateur it1, it2;
+	Table_curseur c1, c2;
 	
-	it1 = premier_iterateur_table( ens1->table );
-	it2 = premier_iterateur_table( ens2->table );
+	c1 = premier_curseur_table( ens1->table );
+	c2 = premier_curseur_table( ens2->table );
 	for( 
 		;
-		( ! iterateur_est_vide(it1) ) && ( ! iterateur_est_vide(it2) );
-		next_iterators( &it1, &it2 )
+		( ! curseur_est_vide(c1) ) && ( ! curseur_est_vide(c2) );
+		next_iterators( &c1, &c2 )
 	){
 		int cmp;
 		if( ens1->comparer_element ){
-			cmp = ens1->comparer_element( get_cle( it1 ), get_cle( it2 ) );
+			cmp = ens1->comparer_element( 
+				get_cle_curseur( c1 ), get_cle_curseur( c2 ) 
+			);
 		}else{
-			cmp = get_cle( it1 ) -  get_cle( it2 );
+			intptr_t e1 = get_cle_curseur( c1 );
+			intptr_t e2 = get_cle_curseur( c2 );
+			cmp = ( e1 < e2 ) ? -1 : ( e1 > e2 );
 		}
 	 	if( cmp > 0 ) return 1;
 	 	if( cmp < 0 ) return -1;
 	}
-	if( iterateur_est_vide(it1) && iterateur_est_vide(it2) )
+	if( curseur_est_vide(c1) && curseur_est_vide(c2) )
 		return 0;
-	if( iterateur_est_vide(it1) ) 
+	if( curseur_est_vide(c1) ) 
 		return -1;
 	return 1;
 }
@@ -83,6 +115,7 @@ Ensemble * creer_ensemble(
 	result->comparer_element = comparer_element;
 	result->copier_element = copier_element;
 	result->supprimer_element = supprimer_element;
+	result->hash = 0;
 	return result;
 }
 
@@ -94,7 +127,9 @@ void liberer_ensemble( Ensemble * ens ){
 }
 
 void ajouter_element( Ensemble * ensemble, const intptr_t element ){
+	unsigned int taille = taille_table( ensemble->table );
 	add_table( ensemble->table, element, (intptr_t) NULL );
+	mettre_a_jour_hash( ensemble, taille, element );
 }
 
 
@@ -106,6 +141,24 @@ void ajouter_elements( Ensemble * ens1, const Ensemble * ens2 ){
 	pour_tout_element( ens2, action_ajouter_element, ens1 );
 }
 
+void ajouter_elements_tries(
+	Ensemble * ensemble, const intptr_t * elements, int n
+){
+	int i;
+	if( taille_table( ensemble->table ) != 0 ){
+		for( i=0; i<n; i++ ){
+			ajouter_element( ensemble, elements[i] );
+		}
+		return;
+	}
+	add_table_triee( ensemble->table, elements, NULL, n );
+	if( ! ensemble->comparer_element ){
+		for( i=0; i<n; i++ ){
+			ensemble->hash ^= hash_element( elements[i] );
+		}
+	}
+}
+
 void transferer_elements_et_libere(
 	Ensemble * destination, Ensemble * source 
 ){
@@ -121,7 +174,9 @@ void transferer_elements(
 }
 
 void retirer_element( Ensemble * ensemble, const intptr_t element ){
+	unsigned int taille = taille_table( ensemble->table );
 	delete_table( ensemble->table, element );
+	mettre_a_jour_hash( ensemble, taille, element );
 }
 
 void action_retirer_elements( const intptr_t element, void* ens ){
@@ -134,21 +189,33 @@ void retirer_elements( Ensemble * ens1, const Ensemble * ens2 ){
 
 void vider_ensemble( Ensemble * ensemble ){
 	vider_table( ensemble->table );
+	ensemble->hash = 0;
 }
 
 int est_dans_l_ensemble( const Ensemble * ensemble, intptr_t element ){
+	if( ! ensemble->comparer_element ){
+		return chercher_cle_entiere( ensemble->table, element ) != NULL;
+	}
 	Table_iterateur it = trouver_table( ensemble->table, element );
 	return ! avl_t_is_null( &it ); 
 }
 
-void action_taille_ensemble( const intptr_t element, void* taille ){
-	(*(int*) taille)+=1;
+unsigned int taille_ensemble( const Ensemble* ensemble ){
+	return taille_table( ensemble->table );
 }
 
-unsigned int taille_ensemble( const Ensemble* ensemble ){
-	int taille = 0;
-	pour_tout_element( ensemble, action_taille_ensemble, &taille );
-	return taille;
+uint64_t hash_ensemble( const Ensemble* ensemble ){
+	return ensemble->hash;
+}
+
+int ensembles_egaux( const Ensemble* ens1, const Ensemble* ens2 ){
+	if( 
+		ens1->hash != ens2->hash 
+		|| taille_ensemble( ens1 ) != taille_ensemble( ens2 ) 
+	){
+		return 0;
+	}
+	return comparer_ensemble( ens1, ens2 ) == 0;
 }
 
 typedef struct {
@@ -205,6 +272,9 @@ void swap_ensemble( Ensemble* ens1, Ensemble* ens2 ){
 	void* tmp = ens1->table;
 	ens1->table = ens2->table;
 	ens2->table = tmp;
+	uint64_t hash = ens1->hash;
+	ens1->hash = ens2->hash;
+	ens2->hash = hash;
 }
 void deplacer_ensemble( Ensemble* ens1, Ensemble* ens2 ){
 	swap_ensemble( ens1, ens2 );
@@ -212,11 +282,16 @@ void deplacer_ensemble( Ensemble* ens1, Ensemble* ens2 ){
 }
 
 Ensemble* copier_ensemble( const Ensemble* ensemble ){
-	Ensemble* res = creer_ensemble(
-		ensemble->comparer_element, ensemble->copier_element,
-		ensemble->supprimer_element
-	);
-	ajouter_elements( res, ensemble  );
+	Ensemble* res = (Ensemble*) xmalloc( sizeof(Ensemble) );
+	*res = *ensemble;
+	res->table = copier_table( ensemble->table );
+	return res;
+}
+
+Ensemble* cloner_ensemble( const Ensemble* ensemble ){
+	Ensemble* res = (Ensemble*) xmalloc( sizeof(Ensemble) );
+	*res = *ensemble;
+	res->table = cloner_table( ensemble->table, NULL );
 	return res;
 }
 
@@ -254,6 +329,10 @@ Ensemble_iterateur premier_iterateur_ensemble( const Ensemble* ensemble ){
 	return premier_iterateur_table( ensemble->table );
 }
 
+Ensemble_iterateur dernier_iterateur_ensemble( const Ensemble* ensemble ){
+	return dernier_iterateur_table( ensemble->table );
+}
+
 Ensemble_iterateur iterateur_suivant_ensemble(
 	const Ensemble_iterateur iterateur
 ){
@@ -271,3 +350,35 @@ int iterateur_ensemble_est_vide( Ensemble_iterateur iterateur ){
 intptr_t get_element( Ensemble_iterateur it ){
 	return get_cle( it );
 }
+
+Ensemble_curseur premier_curseur_ensemble( const Ensemble* ensemble ){
+	return premier_curseur_table( ensemble->table );
+}
+
+Ensemble_curseur dernier_curseur_ensemble( const Ensemble* ensemble ){
+	return dernier_curseur_table( ensemble->table );
+}
+
+Ensemble_curseur curseur_suivant_ensemble( Ensemble_curseur curseur ){
+	return curseur_suivant_table( curseur );
+}
+
+Ensemble_curseur curseur_precedent_ensemble( Ensemble_curseur curseur ){
+	return curseur_precedent_table( curseur );
+}
+
+int curseur_ensemble_est_vide( Ensemble_curseur curseur ){
+	return curseur_est_vide( curseur );
+}
+
+intptr_t get_element_curseur( Ensemble_curseur curseur ){
+	return get_cle_curseur( curseur );
+}
+
+void ensemble_memoire( const Ensemble* ensemble, Ensemble_memoire_stats* stats ){
+	memset( stats, 0, sizeof(Ensemble_memoire_stats) );
+	compter_memoire( &stats->ensemble, 1, sizeof(Ensemble) );
+	table_memoire( ensemble->table, &stats->table );
+	ajouter_memoire( &stats->total, stats->ensemble );
+	ajouter_memoire( &stats->total, stats->table.total );
+}
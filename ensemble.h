@@ -35,6 +35,10 @@ struct Ensemble {
 	int (*comparer_element)( const intptr_t elem1, const intptr_t elem2 );
 	intptr_t (*copier_element)( const intptr_t elem );
 	void (*supprimer_element)(intptr_t elem );
+	// Empreinte des éléments, mise à jour à chaque modification (voir 
+	// hash_ensemble()). Elle vaut toujours 0 si l'ensemble ne contient pas
+	// des entiers.
+	uint64_t hash;
 };
 
 typedef struct Ensemble Ensemble;
@@ -44,6 +48,13 @@ typedef struct Ensemble Ensemble;
  */
 typedef struct avl_traverser Ensemble_iterateur;
 
+/*
+ * Curseur sur les éléments d'un ensemble : il a la taille d'un pointeur et 
+ * parcourt les éléments dans le même ordre qu'un Ensemble_iterateur (voir 
+ * Table_curseur). À préférer dans les boucles.
+ */
+typedef Table_curseur Ensemble_curseur;
+
 /*
  * Renvoie un nouvel ensemble vide.
  *
@@ -85,6 +96,17 @@ void ajouter_element( Ensemble * ensemble, const intptr_t  element );
  */
 void ajouter_elements( Ensemble * ens1, const Ensemble * ens2 );
 
+/*
+ * Ajoute à l'ensemble les 'n' éléments du tableau passé en paramètre.
+ *
+ * Les éléments doivent être triés par ordre strictement croissant (pour la
+ * fonction de comparaison des éléments de l'ensemble). Si l'ensemble est
+ * vide, il est construit en temps linéaire.
+ */
+void ajouter_elements_tries(
+	Ensemble * ensemble, const intptr_t * elements, int n
+);
+
 /*
  * Transfère tous les élément de l'ensemble source dans l'ensemble destination
  * La mémoire de l'ensemble source n'est pas libérer.
@@ -141,10 +163,53 @@ unsigned int taille_ensemble( const Ensemble* ensemble );
 int comparer_ensemble( const Ensemble* ens1, const Ensemble*  ens2 );
 
 /*
- * Renvoie une copie de l'ensemble passé en paramètre
+ * Renvoie une empreinte de 64 bits d'un ensemble d'entiers, en temps 
+ * constant.
+ *
+ * L'empreinte est le ou exclusif des empreintes des éléments : elle ne 
+ * dépend que du contenu de l'ensemble, et deux ensembles égaux ont la même
+ * empreinte. Deux ensembles d'empreintes différentes sont donc différents.
+ * Elle est mise à jour en temps constant à chaque ajout ou retrait d'un 
+ * élément.
+ *
+ * Pour un ensemble qui ne contient pas des entiers (c'est-à-dire créé avec 
+ * une fonction de comparaison), l'empreinte vaut toujours 0.
+ */
+uint64_t hash_ensemble( const Ensemble* ensemble );
+
+/*
+ * Renvoie la contribution d'un entier à l'empreinte d'un ensemble : 
+ * l'empreinte est le ou exclusif des contributions de ses éléments.
+ */
+uint64_t hash_element( const intptr_t element );
+
+/*
+ * Renvoie 1 si les deux ensembles contiennent les mêmes éléments, et 0 
+ * sinon.
+ *
+ * Deux ensembles de tailles ou d'empreintes différentes sont rejetés en 
+ * temps constant ; sinon, les ensembles sont comparés avec 
+ * comparer_ensemble().
+ */
+int ensembles_egaux( const Ensemble* ens1, const Ensemble* ens2 );
+
+/*
+ * Renvoie une copie de l'ensemble passé en paramètre.
+ *
+ * La copie est faite en temps constant : les deux ensembles partagent leur 
+ * mémoire jusqu'à ce que l'un d'eux soit modifié. La première modification
+ * clone alors tout l'ensemble, en temps linéaire (voir copier_table()).
  */
 Ensemble* copier_ensemble( const Ensemble* ensemble );
 
+/*
+ * Renvoie une copie profonde de l'ensemble passé en paramètre.
+ *
+ * La copie ne partage aucune mémoire avec l'ensemble d'origine. Elle est 
+ * faite en temps linéaire par clonage de l'arbre (voir cloner_table()).
+ */
+Ensemble* cloner_ensemble( const Ensemble* ensemble );
+
 /*
  * Crée un nouvel ensemble qui est la copie de deux ensembles passés en 
  * paramètre
@@ -210,6 +275,11 @@ Ensemble_iterateur trouver_ensemble(
  */
 Ensemble_iterateur premier_iterateur_ensemble( const Ensemble* ensemble );
 
+/*
+ * Renvoie un itérateur positionné sur le dernier élement de l'ensemble.
+ */
+Ensemble_iterateur dernier_iterateur_ensemble( const Ensemble* ensemble );
+
 /*
  * Renvoie l'iterateur suivant.
  *
@@ -251,4 +321,45 @@ int iterateur_ensemble_est_vide( Ensemble_iterateur iterateur );
  */
 intptr_t get_element( Ensemble_iterateur it );
 
+/*
+ * Renvoie un curseur positionné sur le premier (resp. le dernier) élément de
+ * l'ensemble, ou le curseur vide si l'ensemble est vide.
+ */
+Ensemble_curseur premier_curseur_ensemble( const Ensemble* ensemble );
+Ensemble_curseur dernier_curseur_ensemble( const Ensemble* ensemble );
+
+/*
+ * Renvoie le curseur positionné sur l'élément suivant (resp. précédent), ou
+ * le curseur vide s'il n'y en a pas.
+ */
+Ensemble_curseur curseur_suivant_ensemble( Ensemble_curseur curseur );
+Ensemble_curseur curseur_precedent_ensemble( Ensemble_curseur curseur );
+
+/*
+ * Renvoie 1 si le curseur passé en paramètre est vide.
+ * Renvoie 0 sinon.
+ */
+int curseur_ensemble_est_vide( Ensemble_curseur curseur );
+
+/*
+ * Renvoie l'élément associé au curseur passé en paramètre.
+ */
+intptr_t get_element_curseur( Ensemble_curseur curseur );
+
+/*
+ * Détail de la mémoire occupée par un ensemble : la structure Ensemble et 
+ * sa table (voir table_memoire()).
+ */
+typedef struct Ensemble_memoire_stats {
+	Memoire ensemble;
+	Table_memoire_stats table;
+	Memoire total;
+} Ensemble_memoire_stats;
+
+/*
+ * Calcule la mémoire occupée par l'ensemble, en temps constant. La mémoire
+ * des éléments alloués par 'copier_element' n'est pas comptée.
+ */
+void ensemble_memoire( const Ensemble* ensemble, Ensemble_memoire_stats* stats );
+
 #endif
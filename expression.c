@@ -0,0 +1,303 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "expression.h"
+#include "outils.h"
+
+#include <limits.h>
+#include <string.h>
+
+/*
+ * Les lettres d'une position de l'expression.
+ */
+typedef struct {
+	int nb_lettres;
+	char lettres[UCHAR_MAX];
+} Position;
+
+/*
+ * Ce que l'on sait d'une sous-expression pour la construction de Glushkov :
+ * si elle reconnaît le mot vide, et les positions par lesquelles ses mots 
+ * peuvent commencer et finir.
+ */
+typedef struct {
+	int annulable;
+	Ensemble * premiers;
+	Ensemble * derniers;
+} Fragment;
+
+typedef struct {
+	const char * courant;
+	int erreur;
+	Automate * automate;
+	Position * positions;
+	int nb_positions;
+	int capacite;
+} Analyseur;
+
+Fragment fragment_vide(){
+	Fragment res;
+	res.annulable = 1;
+	res.premiers = creer_ensemble( NULL, NULL, NULL );
+	res.derniers = creer_ensemble( NULL, NULL, NULL );
+	return res;
+}
+
+void liberer_fragment( Fragment fragment ){
+	liberer_ensemble( fragment.premiers );
+	liberer_ensemble( fragment.derniers );
+}
+
+/*
+ * Ajoute les transitions qui relient chaque position de 'origines' à chaque
+ * position de 'fins'.
+ */
+void relier_positions( 
+	Analyseur * analyseur, const Ensemble * origines, const Ensemble * fins 
+){
+	Ensemble_curseur it_origine, it_fin;
+	for(
+		it_origine = premier_curseur_ensemble( origines );
+		! curseur_ensemble_est_vide( it_origine );
+		it_origine = curseur_suivant_ensemble( it_origine )
+	){
+		for(
+			it_fin = premier_curseur_ensemble( fins );
+			! curseur_ensemble_est_vide( it_fin );
+			it_fin = curseur_suivant_ensemble( it_fin )
+		){
+			int fin = get_element_curseur( it_fin );
+			const Position * position = &analyseur->positions[fin];
+			int i;
+			for( i=0; i<position->nb_lettres; i++ ){
+				ajouter_transition( 
+					analyseur->automate, get_element_curseur( it_origine ), 
+					position->lettres[i], fin 
+				);
+			}
+		}
+	}
+}
+
+Fragment analyser_union( Analyseur * analyseur );
+
+/*
+ * Crée une nouvelle position dont les lettres sont données par le tableau
+ * 'presentes'.
+ */
+Fragment creer_position( Analyseur * analyseur, const char * presentes ){
+	if( analyseur->nb_positions == analyseur->capacite ){
+		analyseur->capacite *= 2;
+		analyseur->positions = xrealloc( 
+			analyseur->positions, analyseur->capacite * sizeof(Position) 
+		);
+	}
+	int numero = analyseur->nb_positions++;
+	Position * position = &analyseur->positions[numero];
+	position->nb_lettres = 0;
+	int c;
+	for( c=1; c<=UCHAR_MAX; c++ ){
+		if( presentes[c] ){
+			position->lettres[ position->nb_lettres++ ] = (char) c;
+		}
+	}
+	ajouter_etat( analyseur->automate, numero );
+
+	Fragment res;
+	res.annulable = 0;
+	res.premiers = creer_ensemble( NULL, NULL, NULL );
+	res.derniers = creer_ensemble( NULL, NULL, NULL );
+	ajouter_element( res.premiers, numero );
+	ajouter_element( res.derniers, numero );
+	return res;
+}
+
+/*
+ * Lit une lettre, éventuellement échappée par '\'. Renvoie 0 en fin 
+ * d'expression.
+ */
+unsigned char lire_lettre_expression( Analyseur * analyseur ){
+	if( *analyseur->courant == '\\' ){
+		analyseur->courant++;
+	}
+	if( *analyseur->courant == '\0' ){
+		analyseur->erreur = 1;
+		return 0;
+	}
+	return (unsigned char) *analyseur->courant++;
+}
+
+Fragment analyser_classe( Analyseur * analyseur ){
+	char presentes[UCHAR_MAX+1] = {0};
+	int vide = 1;
+	analyseur->courant++;
+	while( ! analyseur->erreur && *analyseur->courant != ']' ){
+		unsigned char debut = lire_lettre_expression( analyseur );
+		unsigned char fin = debut;
+		if( 
+			! analyseur->erreur 
+			&& analyseur->courant[0] == '-' && analyseur->courant[1] != ']' 
+		){
+			analyseur->courant++;
+			fin = lire_lettre_expression( analyseur );
+			if( fin < debut ){
+				analyseur->erreur = 1;
+			}
+		}
+		if( ! analyseur->erreur ){
+			int c;
+			for( c=debut; c<=fin; c++ ){
+				presentes[c] = 1;
+			}
+			vide = 0;
+		}
+	}
+	if( analyseur->erreur || vide ){
+		analyseur->erreur = 1;
+		return fragment_vide();
+	}
+	analyseur->courant++;
+	return creer_position( analyseur, presentes );
+}
+
+Fragment analyser_atome( Analyseur * analyseur ){
+	char presentes[UCHAR_MAX+1] = {0};
+	switch( *analyseur->courant ){
+		case '(' : {
+			analyseur->courant++;
+			Fragment res = analyser_union( analyseur );
+			if( *analyseur->courant != ')' ){
+				analyseur->erreur = 1;
+			}else{
+				analyseur->courant++;
+			}
+			return res;
+		}
+		case '[' :
+			return analyser_classe( analyseur );
+		case '\0' : case ')' : case ']' : case '|' : case '*' : case '+' : case '?' :
+			analyseur->erreur = 1;
+			return fragment_vide();
+		default : {
+			unsigned char lettre = lire_lettre_expression( analyseur );
+			if( analyseur->erreur ){
+				return fragment_vide();
+			}
+			presentes[lettre] = 1;
+			return creer_position( analyseur, presentes );
+		}
+	}
+}
+
+Fragment analyser_repetition( Analyseur * analyseur ){
+	Fragment res = analyser_atome( analyseur );
+	while( 
+		! analyseur->erreur
+		&& ( *analyseur->courant == '*' || *analyseur->courant == '+' 
+			|| *analyseur->courant == '?' )
+	){
+		char operateur = *analyseur->courant++;
+		if( operateur != '?' ){
+			relier_positions( analyseur, res.derniers, res.premiers );
+		}
+		if( operateur != '+' ){
+			res.annulable = 1;
+		}
+	}
+	return res;
+}
+
+Fragment analyser_concatenation( Analyseur * analyseur ){
+	Fragment res = fragment_vide();
+	while( 
+		! analyseur->erreur
+		&& *analyseur->courant != '\0' && *analyseur->courant != '|' 
+		&& *analyseur->courant != ')' 
+	){
+		Fragment suivant = analyser_repetition( analyseur );
+		relier_positions( analyseur, res.derniers, suivant.premiers );
+		if( res.annulable ){
+			ajouter_elements( res.premiers, suivant.premiers );
+		}
+		if( suivant.annulable ){
+			ajouter_elements( suivant.derniers, res.derniers );
+		}
+		res.annulable = res.annulable && suivant.annulable;
+		swap_ensemble( res.derniers, suivant.derniers );
+		liberer_fragment( suivant );
+	}
+	return res;
+}
+
+Fragment analyser_union( Analyseur * analyseur ){
+	Fragment res = analyser_concatenation( analyseur );
+	while( ! analyseur->erreur && *analyseur->courant == '|' ){
+		analyseur->courant++;
+		Fragment suivant = analyser_concatenation( analyseur );
+		res.annulable = res.annulable || suivant.annulable;
+		ajouter_elements( res.premiers, suivant.premiers );
+		ajouter_elements( res.derniers, suivant.derniers );
+		liberer_fragment( suivant );
+	}
+	return res;
+}
+
+Automate * regex_to_automate( const char * expression ){
+	Analyseur analyseur;
+	analyseur.courant = expression;
+	analyseur.erreur = 0;
+	analyseur.automate = creer_automate();
+	analyseur.capacite = 16;
+	analyseur.positions = xmalloc( analyseur.capacite * sizeof(Position) );
+	// La position 0 est l'état initial
+	analyseur.nb_positions = 1;
+	analyseur.positions[0].nb_lettres = 0;
+	ajouter_etat_initial( analyseur.automate, 0 );
+
+	Fragment res = analyser_union( &analyseur );
+	if( *analyseur.courant != '\0' ){
+		analyseur.erreur = 1;
+	}
+	if( ! analyseur.erreur ){
+		Ensemble * initial = creer_ensemble( NULL, NULL, NULL );
+		ajouter_element( initial, 0 );
+		relier_positions( &analyseur, initial, res.premiers );
+		liberer_ensemble( initial );
+		Ensemble_curseur it;
+		for(
+			it = premier_curseur_ensemble( res.derniers );
+			! curseur_ensemble_est_vide( it );
+			it = curseur_suivant_ensemble( it )
+		){
+			ajouter_etat_final( analyseur.automate, get_element_curseur( it ) );
+		}
+		if( res.annulable ){
+			ajouter_etat_final( analyseur.automate, 0 );
+		}
+	}
+	liberer_fragment( res );
+	xfree( analyseur.positions );
+	if( analyseur.erreur ){
+		liberer_automate( analyseur.automate );
+		return NULL;
+	}
+	return analyseur.automate;
+}
@@ -0,0 +1,59 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef __EXPRESSION_H__
+#define __EXPRESSION_H__
+
+#include "automate.h"
+
+/**
+ * @brief Crée l'automate de Glushkov (automate des positions) d'une 
+ *        expression rationnelle.
+ *
+ * La syntaxe reconnue est la suivante, par priorité croissante :
+ *  - e|f : l'union de deux expressions ;
+ *  - ef : la concaténation de deux expressions ;
+ *  - e*, e+, e? : zéro fois ou plus, une fois ou plus, zéro ou une fois ;
+ *  - (e) : les parenthèses ;
+ *  - [abc], [a-z0-9] : une lettre parmi un ensemble de lettres ou 
+ *    d'intervalles de lettres ;
+ *  - \\c : la lettre c, même si c'est un caractère spécial ;
+ *  - toute autre lettre se représente elle-même.
+ * Les caractères spéciaux sont | * + ? ( ) [ ] et \\. Une expression vide
+ * (ou une branche vide d'une union) représente le mot vide.
+ *
+ * Chaque lettre ou ensemble de lettres de l'expression est une position. 
+ * Si l'expression a m positions, l'automate a exactement m+1 états : l'état 
+ * initial 0, et l'état i pour la i-ème position, dans l'ordre de lecture. 
+ * Toutes les transitions qui arrivent dans l'état i sont étiquetées par les 
+ * lettres de la i-ème position. L'automate n'a pas d'epsilon-transitions.
+ *
+ * La mémoire de l'automate renvoyé est laissée à la charge de 
+ * l'utilisateur.
+ *
+ * @param expression L'expression rationnelle.
+ * @return L'automate de Glushkov, ou NULL si l'expression n'est pas 
+ *         syntaxiquement correcte.
+ */
+Automate * regex_to_automate( const char * expression );
+
+#endif
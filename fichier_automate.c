@@ -0,0 +1,766 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "fichier_automate.h"
+#include "outils.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+_Static_assert( sizeof(int) == sizeof(int32_t), "les int doivent faire 32 bits" );
+
+#define SIGNATURE_FICHIER_AUTOMATE "AUTOMATE"
+#define BOUTISME_FICHIER_AUTOMATE 0x01020304u
+
+typedef struct {
+	char signature[8];
+	uint32_t version;
+	uint32_t boutisme;
+	uint32_t nb_etats;
+	uint32_t nb_lettres;
+	uint32_t nb_initiaux;
+	uint32_t nb_finaux;
+	uint32_t nb_transitions;
+	uint32_t reserve;
+	uint64_t somme_de_controle;
+} En_tete_fichier_automate;
+
+#define FNV_BASE 14695981039346656037ULL
+#define FNV_PREMIER 1099511628211ULL
+
+uint64_t fnv1a( uint64_t hash, const void * donnees, size_t taille ){
+	const unsigned char * octets = (const unsigned char *) donnees;
+	size_t i;
+	for( i=0; i<taille; i++ ){
+		hash ^= octets[i];
+		hash *= FNV_PREMIER;
+	}
+	return hash;
+}
+
+/*
+ * Remplit un tableau avec les éléments de l'ensemble, dans l'ordre croissant.
+ */
+void ensemble_vers_tableau( const Ensemble * ensemble, int32_t * tableau ){
+	Ensemble_curseur it;
+	int i = 0;
+	for(
+		it = premier_curseur_ensemble( ensemble );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
+	){
+		tableau[i++] = (int32_t) get_element_curseur( it );
+	}
+}
+
+typedef struct {
+	int32_t * origines;
+	int32_t * fins;
+	char * lettres;
+	int nb_transitions;
+} data_sauver_t;
+
+void action_sauver_transition( int origine, char lettre, int fin, void* data ){
+	data_sauver_t * info = (data_sauver_t *) data;
+	int i = info->nb_transitions++;
+	info->origines[i] = origine;
+	info->lettres[i] = lettre;
+	info->fins[i] = fin;
+}
+
+void action_compter_transition_a_sauver( int origine, char lettre, int fin, void* data ){
+	(*(int*) data) += 1;
+}
+
+int sauver_automate( const Automate * automate, const char * chemin ){
+	En_tete_fichier_automate en_tete;
+	memset( &en_tete, 0, sizeof(En_tete_fichier_automate) );
+	memcpy( en_tete.signature, SIGNATURE_FICHIER_AUTOMATE, 8 );
+	en_tete.version = VERSION_FICHIER_AUTOMATE;
+	en_tete.boutisme = BOUTISME_FICHIER_AUTOMATE;
+	en_tete.nb_etats = taille_ensemble( get_etats( automate ) );
+	en_tete.nb_lettres = taille_ensemble( get_alphabet( automate ) );
+	en_tete.nb_initiaux = taille_ensemble( get_initiaux( automate ) );
+	en_tete.nb_finaux = taille_ensemble( get_finaux( automate ) );
+	int nb_transitions = 0;
+	pour_toute_transition( 
+		automate, action_compter_transition_a_sauver, &nb_transitions 
+	);
+	en_tete.nb_transitions = nb_transitions;
+
+	// Les tableaux sont rangés dans l'ordre du fichier
+	size_t nb_entiers = 
+		en_tete.nb_etats + en_tete.nb_lettres + en_tete.nb_initiaux + 
+		en_tete.nb_finaux + 2 * (size_t) en_tete.nb_transitions;
+	int32_t * entiers = xmalloc( ( nb_entiers + 1 ) * sizeof(int32_t) );
+	char * lettres = xmalloc( nb_transitions + 1 );
+	int32_t * courant = entiers;
+	ensemble_vers_tableau( get_etats( automate ), courant );
+	courant += en_tete.nb_etats;
+	ensemble_vers_tableau( get_alphabet( automate ), courant );
+	courant += en_tete.nb_lettres;
+	ensemble_vers_tableau( get_initiaux( automate ), courant );
+	courant += en_tete.nb_initiaux;
+	ensemble_vers_tableau( get_finaux( automate ), courant );
+	courant += en_tete.nb_finaux;
+	data_sauver_t data;
+	data.origines = courant;
+	data.fins = courant + nb_transitions;
+	data.lettres = lettres;
+	data.nb_transitions = 0;
+	pour_toute_transition( automate, action_sauver_transition, &data );
+
+	en_tete.somme_de_controle = fnv1a( 
+		fnv1a( FNV_BASE, entiers, nb_entiers * sizeof(int32_t) ),
+		lettres, nb_transitions
+	);
+
+	int res = 0;
+	FILE * fichier = fopen( chemin, "wb" );
+	if( ! fichier ){
+		res = -1;
+	}else{
+		if(
+			fwrite( &en_tete, sizeof(en_tete), 1, fichier ) != 1
+			|| fwrite( entiers, sizeof(int32_t), nb_entiers, fichier ) != nb_entiers
+			|| fwrite( lettres, 1, nb_transitions, fichier ) != (size_t) nb_transitions
+		){
+			res = -1;
+		}
+		if( fclose( fichier ) != 0 ){
+			res = -1;
+		}
+	}
+	xfree( lettres );
+	xfree( entiers );
+	return res;
+}
+
+/*
+ * Ajoute à l'ensemble (vide) les n éléments du tableau, qui doivent être 
+ * strictement croissants. Renvoie 0 si le tableau n'est pas trié.
+ */
+int ajouter_tableau_trie( Ensemble * ensemble, const int32_t * tableau, uint32_t n ){
+	intptr_t * elements = xmalloc( ( n + 1 ) * sizeof(intptr_t) );
+	uint32_t i;
+	for( i=0; i<n; i++ ){
+		if( i > 0 && tableau[i-1] >= tableau[i] ){
+			xfree( elements );
+			return 0;
+		}
+		elements[i] = tableau[i];
+	}
+	ajouter_elements_tries( ensemble, elements, n );
+	xfree( elements );
+	return 1;
+}
+
+/*
+ * Construit l'automate décrit par une projection déjà vérifiée (taille et 
+ * somme de contrôle). Renvoie NULL si un tableau n'est pas trié ou si une 
+ * lettre n'est pas un char.
+ */
+Automate * construire_automate_projete( 
+	const En_tete_fichier_automate * en_tete, const int32_t * entiers,
+	const char * lettres
+){
+	const int32_t * etats = entiers;
+	const int32_t * alphabet = etats + en_tete->nb_etats;
+	const int32_t * initiaux = alphabet + en_tete->nb_lettres;
+	const int32_t * finaux = initiaux + en_tete->nb_initiaux;
+	const int32_t * origines = finaux + en_tete->nb_finaux;
+	const int32_t * fins = origines + en_tete->nb_transitions;
+
+	uint32_t i;
+	for( i=0; i<en_tete->nb_lettres; i++ ){
+		if( alphabet[i] < CHAR_MIN || alphabet[i] > CHAR_MAX ){
+			return NULL;
+		}
+	}
+
+	// Les ensembles sont vides : leurs arbres sont construits en temps 
+	// linéaire. Les états sont ajoutés avant les transitions pour que 
+	// celles-ci n'aient plus qu'à les retrouver.
+	Automate * automate = creer_automate();
+	int valide =
+		ajouter_tableau_trie( automate->etats, etats, en_tete->nb_etats )
+		&& ajouter_tableau_trie( automate->alphabet, alphabet, en_tete->nb_lettres )
+		&& ajouter_tableau_trie( automate->initiaux, initiaux, en_tete->nb_initiaux )
+		&& ajouter_tableau_trie( automate->finaux, finaux, en_tete->nb_finaux )
+		&& ajouter_transitions_triees( 
+			automate, origines, lettres, fins, en_tete->nb_transitions 
+		);
+	if( ! valide ){
+		liberer_automate( automate );
+		return NULL;
+	}
+	return automate;
+}
+
+/*
+ * Projette un fichier en lecture seule, partagée avec les autres processus.
+ * Renvoie NULL si le fichier ne peut pas être projeté ou est plus petit 
+ * qu'un en-tête.
+ */
+void * projeter_fichier( const char * chemin, size_t * taille ){
+	int fd = open( chemin, O_RDONLY );
+	if( fd < 0 ){
+		return NULL;
+	}
+	struct stat informations;
+	if( fstat( fd, &informations ) != 0 ){
+		close( fd );
+		return NULL;
+	}
+	*taille = informations.st_size;
+	if( *taille < sizeof(En_tete_fichier_automate) ){
+		close( fd );
+		return NULL;
+	}
+	void * projection = mmap( NULL, *taille, PROT_READ, MAP_SHARED, fd, 0 );
+	close( fd );
+	if( projection == MAP_FAILED ){
+		return NULL;
+	}
+	return projection;
+}
+
+/*
+ * Vérifie l'en-tête, la taille et la somme de contrôle d'une projection, et
+ * renvoie ses tableaux d'entiers et de lettres. Renvoie 0 si la projection
+ * n'est pas valide.
+ */
+int verifier_projection( 
+	const void * projection, size_t taille, 
+	const int32_t ** entiers, const char ** lettres
+){
+	const En_tete_fichier_automate * en_tete = 
+		(const En_tete_fichier_automate *) projection;
+	*entiers = (const int32_t *) ( en_tete + 1 );
+	size_t nb_entiers = 
+		(size_t) en_tete->nb_etats + en_tete->nb_lettres + en_tete->nb_initiaux 
+		+ en_tete->nb_finaux + 2 * (size_t) en_tete->nb_transitions;
+	if( 
+		memcmp( en_tete->signature, SIGNATURE_FICHIER_AUTOMATE, 8 ) != 0
+		|| en_tete->version != VERSION_FICHIER_AUTOMATE
+		|| en_tete->boutisme != BOUTISME_FICHIER_AUTOMATE
+		|| en_tete->nb_transitions > INT32_MAX
+		|| taille != sizeof(En_tete_fichier_automate) 
+			+ nb_entiers * sizeof(int32_t) + en_tete->nb_transitions
+	){
+		return 0;
+	}
+	*lettres = (const char *) ( *entiers + nb_entiers );
+	uint64_t somme = fnv1a( 
+		fnv1a( FNV_BASE, *entiers, nb_entiers * sizeof(int32_t) ),
+		*lettres, en_tete->nb_transitions
+	);
+	return somme == en_tete->somme_de_controle;
+}
+
+Automate * charger_automate_mmap( const char * chemin ){
+	size_t taille;
+	void * projection = projeter_fichier( chemin, &taille );
+	if( ! projection ){
+		return NULL;
+	}
+	Automate * automate = NULL;
+	const int32_t * entiers;
+	const char * lettres;
+	if( verifier_projection( projection, taille, &entiers, &lettres ) ){
+		automate = construire_automate_projete( 
+			(const En_tete_fichier_automate *) projection, entiers, lettres 
+		);
+	}
+	munmap( projection, taille );
+	return automate;
+}
+
+struct Automate_projete {
+	void * projection;
+	size_t taille;
+	const int32_t * etats;
+	const int32_t * initiaux;
+	const int32_t * finaux;
+	const int32_t * origines;
+	const int32_t * fins;
+	const char * lettres;
+	uint32_t nb_etats;
+	uint32_t nb_initiaux;
+	uint32_t nb_finaux;
+	uint32_t nb_transitions;
+};
+
+/*
+ * Renvoie 1 si le tableau est strictement croissant.
+ */
+int tableau_strictement_croissant( const int32_t * tableau, uint32_t n ){
+	uint32_t i;
+	for( i=1; i<n; i++ ){
+		if( tableau[i-1] >= tableau[i] ){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * Compare la transition i de l'automate projeté au couple (origine, lettre).
+ */
+static inline int comparer_transition_projetee( 
+	const Automate_projete * automate, uint32_t i, int origine, char lettre 
+){
+	if( automate->origines[i] != origine ){
+		return automate->origines[i] < origine ? -1 : 1;
+	}
+	if( automate->lettres[i] != lettre ){
+		return automate->lettres[i] < lettre ? -1 : 1;
+	}
+	return 0;
+}
+
+Automate_projete * projeter_automate( const char * chemin ){
+	size_t taille;
+	void * projection = projeter_fichier( chemin, &taille );
+	if( ! projection ){
+		return NULL;
+	}
+	const int32_t * entiers;
+	const char * lettres;
+	if( ! verifier_projection( projection, taille, &entiers, &lettres ) ){
+		munmap( projection, taille );
+		return NULL;
+	}
+	const En_tete_fichier_automate * en_tete = 
+		(const En_tete_fichier_automate *) projection;
+	Automate_projete * automate = xmalloc( sizeof(Automate_projete) );
+	automate->projection = projection;
+	automate->taille = taille;
+	automate->nb_etats = en_tete->nb_etats;
+	automate->nb_initiaux = en_tete->nb_initiaux;
+	automate->nb_finaux = en_tete->nb_finaux;
+	automate->nb_transitions = en_tete->nb_transitions;
+	automate->etats = entiers;
+	automate->initiaux = automate->etats + en_tete->nb_etats + en_tete->nb_lettres;
+	automate->finaux = automate->initiaux + en_tete->nb_initiaux;
+	automate->origines = automate->finaux + en_tete->nb_finaux;
+	automate->fins = automate->origines + en_tete->nb_transitions;
+	automate->lettres = lettres;
+
+	// Les recherches dichotomiques supposent les tableaux triés
+	int valide = 
+		tableau_strictement_croissant( automate->etats, automate->nb_etats )
+		&& tableau_strictement_croissant( automate->initiaux, automate->nb_initiaux )
+		&& tableau_strictement_croissant( automate->finaux, automate->nb_finaux );
+	uint32_t i;
+	for( i=1; valide && i<automate->nb_transitions; i++ ){
+		int cmp = comparer_transition_projetee( 
+			automate, i-1, automate->origines[i], automate->lettres[i] 
+		);
+		valide = cmp < 0 || ( cmp == 0 && automate->fins[i-1] < automate->fins[i] );
+	}
+	if( ! valide ){
+		liberer_automate_projete( automate );
+		return NULL;
+	}
+	return automate;
+}
+
+void liberer_automate_projete( Automate_projete * automate ){
+	munmap( automate->projection, automate->taille );
+	xfree( automate );
+}
+
+const int * delta_projete( 
+	const Automate_projete * automate, int origine, char lettre, int * nb 
+){
+	// Première transition qui n'est pas avant (origine, lettre)
+	uint32_t debut = 0;
+	uint32_t fin = automate->nb_transitions;
+	while( debut < fin ){
+		uint32_t milieu = debut + ( fin - debut ) / 2;
+		if( comparer_transition_projetee( automate, milieu, origine, lettre ) < 0 ){
+			debut = milieu + 1;
+		}else{
+			fin = milieu;
+		}
+	}
+	for( 
+		fin = debut; 
+		fin < automate->nb_transitions 
+		&& comparer_transition_projetee( automate, fin, origine, lettre ) == 0;
+		fin++
+	);
+	*nb = fin - debut;
+	return automate->fins + debut;
+}
+
+/*
+ * Compare deux entiers, pour qsort().
+ */
+int comparer_entiers_lus( const void* a, const void* b ){
+	int e1 = *(const int*) a;
+	int e2 = *(const int*) b;
+	if( e1 < e2 ) return -1;
+	if( e1 > e2 ) return 1;
+	return 0;
+}
+
+/*
+ * Renvoie 1 si l'élément est dans le tableau trié.
+ */
+int est_dans_le_tableau( const int32_t * tableau, uint32_t n, int element ){
+	uint32_t debut = 0;
+	uint32_t fin = n;
+	while( debut < fin ){
+		uint32_t milieu = debut + ( fin - debut ) / 2;
+		if( tableau[milieu] < element ){
+			debut = milieu + 1;
+		}else{
+			fin = milieu;
+		}
+	}
+	return debut < n && tableau[debut] == element;
+}
+
+int le_mot_est_reconnu_projete( 
+	const Automate_projete * automate, const char * mot 
+){
+	// Les états courants sont triés et sans doublons : ce sont en général 
+	// des états de l'automate, mais rien ne l'impose dans le fichier.
+	uint32_t capacite = 
+		( automate->nb_etats > automate->nb_initiaux ? 
+			automate->nb_etats : automate->nb_initiaux ) + 1;
+	int * courants = xmalloc( capacite * sizeof(int) );
+	int * suivants = xmalloc( capacite * sizeof(int) );
+	uint32_t nb_courants = automate->nb_initiaux;
+	memcpy( courants, automate->initiaux, nb_courants * sizeof(int) );
+	for( ; *mot && nb_courants > 0; mot++ ){
+		uint32_t nb_suivants = 0;
+		uint32_t i;
+		for( i=0; i<nb_courants; i++ ){
+			int nb;
+			const int * fins = delta_projete( automate, courants[i], *mot, &nb );
+			if( nb_suivants + nb > capacite ){
+				capacite = 2 * ( nb_suivants + nb );
+				suivants = xrealloc( suivants, capacite * sizeof(int) );
+				courants = xrealloc( courants, capacite * sizeof(int) );
+			}
+			memcpy( suivants + nb_suivants, fins, nb * sizeof(int) );
+			nb_suivants += nb;
+		}
+		// Un seul état courant donne des suivants déjà triés et distincts
+		if( nb_courants > 1 ){
+			qsort( suivants, nb_suivants, sizeof(int), comparer_entiers_lus );
+			uint32_t j = 0;
+			for( i=0; i<nb_suivants; i++ ){
+				if( j == 0 || suivants[j-1] != suivants[i] ){
+					suivants[j++] = suivants[i];
+				}
+			}
+			nb_suivants = j;
+		}
+		int * echange = courants;
+		courants = suivants;
+		suivants = echange;
+		nb_courants = nb_suivants;
+	}
+	int reconnu = 0;
+	uint32_t i;
+	for( i=0; ! reconnu && i<nb_courants; i++ ){
+		reconnu = est_dans_le_tableau( 
+			automate->finaux, automate->nb_finaux, courants[i] 
+		);
+	}
+	xfree( suivants );
+	xfree( courants );
+	return reconnu;
+}
+
+/*
+ * Tableaux d'entiers qui grandissent au fil de la lecture.
+ */
+typedef struct {
+	int * elements;
+	int taille;
+	int capacite;
+} Tableau_lu;
+
+void ajouter_tableau_lu( Tableau_lu * tableau, int element ){
+	if( tableau->taille == tableau->capacite ){
+		tableau->capacite = tableau->capacite ? 2 * tableau->capacite : 64;
+		tableau->elements = xrealloc( 
+			tableau->elements, tableau->capacite * sizeof(int) 
+		);
+	}
+	tableau->elements[ tableau->taille++ ] = element;
+}
+
+typedef struct {
+	const char * courant;
+	const char * fin;
+} Lecteur_texte;
+
+void passer_les_blancs( Lecteur_texte * lecteur ){
+	while( 
+		lecteur->courant < lecteur->fin 
+		&& ( *lecteur->courant == ' ' || *lecteur->courant == '\t' 
+			|| *lecteur->courant == '\r' )
+	){
+		lecteur->courant++;
+	}
+}
+
+int est_fin_de_ligne( const Lecteur_texte * lecteur ){
+	return 
+		lecteur->courant == lecteur->fin 
+		|| *lecteur->courant == '\n' || *lecteur->courant == '#';
+}
+
+void passer_la_ligne( Lecteur_texte * lecteur ){
+	const char * fin_ligne = memchr( 
+		lecteur->courant, '\n', lecteur->fin - lecteur->courant 
+	);
+	lecteur->courant = fin_ligne ? fin_ligne + 1 : lecteur->fin;
+}
+
+/*
+ * Lit un mot-clé suivi d'un blanc. Renvoie 0, sans rien consommer, si le 
+ * texte ne commence pas par ce mot-clé.
+ */
+int lire_mot_cle( Lecteur_texte * lecteur, const char * mot_cle ){
+	size_t n = strlen( mot_cle );
+	if( 
+		(size_t) ( lecteur->fin - lecteur->courant ) > n
+		&& memcmp( lecteur->courant, mot_cle, n ) == 0
+		&& ( lecteur->courant[n] == ' ' || lecteur->courant[n] == '\t' )
+	){
+		lecteur->courant += n;
+		return 1;
+	}
+	return 0;
+}
+
+/*
+ * Renvoie 1 si le lecteur est en fin de texte ou sur un blanc, une fin de 
+ * ligne ou un commentaire, c'est-à-dire si le mot qui vient d'être lu est 
+ * bien séparé du suivant.
+ */
+int est_un_separateur( const Lecteur_texte * lecteur ){
+	return 
+		est_fin_de_ligne( lecteur )
+		|| *lecteur->courant == ' ' || *lecteur->courant == '\t' 
+		|| *lecteur->courant == '\r';
+}
+
+/*
+ * Lit un entier précédé de blancs et suivi d'un séparateur. Renvoie 0 en 
+ * cas d'erreur.
+ */
+int lire_entier( Lecteur_texte * lecteur, int * entier ){
+	passer_les_blancs( lecteur );
+	int negatif = 0;
+	if( lecteur->courant < lecteur->fin && *lecteur->courant == '-' ){
+		negatif = 1;
+		lecteur->courant++;
+	}
+	const char * debut = lecteur->courant;
+	long long valeur = 0;
+	while( 
+		lecteur->courant < lecteur->fin 
+		&& *lecteur->courant >= '0' && *lecteur->courant <= '9' 
+	){
+		valeur = 10 * valeur + ( *lecteur->courant - '0' );
+		if( valeur > (long long) INT32_MAX + negatif ){
+			return 0;
+		}
+		lecteur->courant++;
+	}
+	if( lecteur->courant == debut || ! est_un_separateur( lecteur ) ){
+		return 0;
+	}
+	*entier = (int) ( negatif ? -valeur : valeur );
+	return 1;
+}
+
+/*
+ * Lit une lettre précédée de blancs et suivie d'un séparateur. Renvoie 0 en
+ * cas d'erreur.
+ */
+int lire_lettre( Lecteur_texte * lecteur, char * lettre ){
+	passer_les_blancs( lecteur );
+	if( 
+		lecteur->courant == lecteur->fin || *lecteur->courant == '\n' 
+	){
+		return 0;
+	}
+	*lettre = *lecteur->courant++;
+	return 
+		lecteur->courant < lecteur->fin && *lecteur->courant != '\n' 
+		&& est_un_separateur( lecteur );
+}
+
+/*
+ * Trie un tableau d'entiers lus et en retire les doublons.
+ */
+void ajouter_etats_lus( Automate * automate, Ensemble * ensemble, Tableau_lu * lus ){
+	if( lus->taille == 0 ) return;
+	qsort( lus->elements, lus->taille, sizeof(int), comparer_entiers_lus );
+	intptr_t * elements = xmalloc( ( lus->taille + 1 ) * sizeof(intptr_t) );
+	int i, n = 0;
+	for( i=0; i<lus->taille; i++ ){
+		if( n == 0 || elements[n-1] != lus->elements[i] ){
+			elements[n++] = lus->elements[i];
+		}
+	}
+	ajouter_elements_tries( ensemble, elements, n );
+	ajouter_elements_tries( automate->etats, elements, n );
+	xfree( elements );
+}
+
+/*
+ * Renvoie 1 si l'état fait partie des états 0 à nb_etats-1 annoncés par 
+ * l'en-tête, ou s'il n'y a pas d'en-tête.
+ */
+int etat_annonce( int etat, int en_tete, int nb_etats ){
+	return ! en_tete || ( etat >= 0 && etat < nb_etats );
+}
+
+Automate * charger_automate_texte( const char * chemin ){
+	int fd = open( chemin, O_RDONLY );
+	if( fd < 0 ){
+		return NULL;
+	}
+	struct stat informations;
+	if( fstat( fd, &informations ) != 0 ){
+		close( fd );
+		return NULL;
+	}
+	size_t taille = informations.st_size;
+	void * projection = NULL;
+	if( taille > 0 ){
+		projection = mmap( NULL, taille, PROT_READ, MAP_PRIVATE, fd, 0 );
+		if( projection == MAP_FAILED ){
+			close( fd );
+			return NULL;
+		}
+		posix_madvise( projection, taille, POSIX_MADV_SEQUENTIAL );
+	}
+	close( fd );
+
+	Lecteur_texte lecteur;
+	lecteur.courant = (const char *) projection;
+	lecteur.fin = lecteur.courant + taille;
+
+	Tableau_lu origines = { NULL, 0, 0 };
+	Tableau_lu fins = { NULL, 0, 0 };
+	Tableau_lu initiaux = { NULL, 0, 0 };
+	Tableau_lu finaux = { NULL, 0, 0 };
+	char * lettres = NULL;
+	int nb_etats = 0;
+	int en_tete = 0;
+	int premiere_instruction = 1;
+	int valide = 1;
+
+	while( valide && lecteur.courant < lecteur.fin ){
+		passer_les_blancs( &lecteur );
+		if( est_fin_de_ligne( &lecteur ) ){
+			passer_la_ligne( &lecteur );
+			continue;
+		}
+		int origine, fin;
+		char lettre;
+		if( lire_mot_cle( &lecteur, "etats" ) ){
+			valide = premiere_instruction 
+				&& lire_entier( &lecteur, &nb_etats ) && nb_etats >= 0;
+			en_tete = 1;
+		}else if( lire_mot_cle( &lecteur, "initial" ) ){
+			valide = 
+				lire_entier( &lecteur, &origine )
+				&& etat_annonce( origine, en_tete, nb_etats );
+			if( valide ) ajouter_tableau_lu( &initiaux, origine );
+		}else if( lire_mot_cle( &lecteur, "final" ) ){
+			valide = 
+				lire_entier( &lecteur, &origine )
+				&& etat_annonce( origine, en_tete, nb_etats );
+			if( valide ) ajouter_tableau_lu( &finaux, origine );
+		}else{
+			valide = 
+				lire_entier( &lecteur, &origine )
+				&& lire_lettre( &lecteur, &lettre )
+				&& lire_entier( &lecteur, &fin )
+				&& etat_annonce( origine, en_tete, nb_etats )
+				&& etat_annonce( fin, en_tete, nb_etats );
+			if( valide ){
+				int capacite = origines.capacite;
+				ajouter_tableau_lu( &origines, origine );
+				ajouter_tableau_lu( &fins, fin );
+				if( capacite != origines.capacite ){
+					lettres = xrealloc( lettres, origines.capacite );
+				}
+				lettres[ origines.taille - 1 ] = lettre;
+			}
+		}
+		premiere_instruction = 0;
+		if( valide ){
+			passer_les_blancs( &lecteur );
+			valide = est_fin_de_ligne( &lecteur );
+			passer_la_ligne( &lecteur );
+		}
+	}
+	if( projection ){
+		munmap( projection, taille );
+	}
+
+	Automate * automate = NULL;
+	if( valide ){
+		automate = creer_automate();
+		ajouter_transitions_en_masse( 
+			automate, origines.elements, lettres, fins.elements, origines.taille 
+		);
+		if( nb_etats > 0 ){
+			intptr_t * etats = xmalloc( nb_etats * sizeof(intptr_t) );
+			int i;
+			for( i=0; i<nb_etats; i++ ){
+				etats[i] = i;
+			}
+			ajouter_elements_tries( automate->etats, etats, nb_etats );
+			xfree( etats );
+		}
+		ajouter_etats_lus( automate, automate->initiaux, &initiaux );
+		ajouter_etats_lus( automate, automate->finaux, &finaux );
+	}
+	if( lettres ) xfree( lettres );
+	if( origines.elements ) xfree( origines.elements );
+	if( fins.elements ) xfree( fins.elements );
+	if( initiaux.elements ) xfree( initiaux.elements );
+	if( finaux.elements ) xfree( finaux.elements );
+	return automate;
+}
@@ -0,0 +1,177 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef __FICHIER_AUTOMATE_H__
+#define __FICHIER_AUTOMATE_H__
+
+#include "automate.h"
+
+/**
+ * @brief Version courante du format binaire des automates.
+ */
+#define VERSION_FICHIER_AUTOMATE 1
+
+/**
+ * @brief Sauve un automate dans un fichier binaire.
+ *
+ * Le fichier commence par un en-tête (signature, version, boutisme, nombre 
+ * d'états, de lettres, d'états initiaux, d'états finaux et de transitions, 
+ * somme de contrôle FNV-1a du contenu), suivi de tableaux d'entiers de 32 
+ * bits : les états, les lettres, les états initiaux, les états finaux, les 
+ * origines et les fins des transitions, puis des lettres des transitions sur 
+ * un octet chacune. Tous les tableaux sont triés.
+ *
+ * Le fichier ne contient aucun pointeur : il peut être chargé à n'importe 
+ * quelle adresse, avec charger_automate_mmap(), ou interrogé directement 
+ * avec projeter_automate(). Les entiers sont écrits dans le boutisme de la 
+ * machine.
+ *
+ * @param automate L'automate à sauver.
+ * @param chemin Le chemin du fichier à écrire.
+ * @return 0 en cas de succès, -1 en cas d'erreur (errno est alors 
+ *         positionné).
+ */
+int sauver_automate( const Automate * automate, const char * chemin );
+
+/**
+ * @brief Charge un automate sauvé par sauver_automate().
+ *
+ * Le fichier est projeté en mémoire en lecture seule, ce qui évite de le 
+ * recopier dans un tampon. L'en-tête, la taille du fichier et la somme de 
+ * contrôle sont vérifiés, puis l'automate est reconstruit dans des arbres 
+ * privés, alloués sur le tas : la projection est libérée avant le retour, 
+ * et deux processus qui chargent le même fichier ne partagent donc aucune 
+ * page de l'automate. Pour lire l'automate sans le recopier, voir 
+ * projeter_automate().
+ *
+ * Tous les tableaux doivent être triés, et leur ordre est vérifié. Les 
+ * ensembles d'états et l'alphabet sont chargés en temps linéaire, puis les 
+ * transitions sont ajoutées sans être triées de nouveau avec 
+ * ajouter_transitions_triees(). Chaque extrémité de transition est 
+ * toutefois recherchée dans l'ensemble des états : le chargement coûte 
+ * O(n log n), où n est la taille du fichier.
+ *
+ * La mémoire de l'automate renvoyé est laissée à la charge de 
+ * l'utilisateur.
+ *
+ * @param chemin Le chemin du fichier à lire.
+ * @return L'automate chargé, ou NULL si le fichier ne peut pas être lu ou 
+ *         n'est pas valide.
+ */
+Automate * charger_automate_mmap( const char * chemin );
+
+/**
+ * @brief Un automate lu directement dans la projection en mémoire d'un 
+ *        fichier sauvé par sauver_automate().
+ */
+typedef struct Automate_projete Automate_projete;
+
+/**
+ * @brief Projette en mémoire un fichier sauvé par sauver_automate(), sans 
+ *        le recopier.
+ *
+ * Le fichier est projeté en lecture seule et partagée : la projection 
+ * appartient à l'automate renvoyé et reste en place jusqu'à 
+ * liberer_automate_projete(). Les requêtes (delta_projete(), 
+ * le_mot_est_reconnu_projete()) sont faites par recherche dichotomique 
+ * dans les tableaux triés du fichier, sans construire d'arbres : plusieurs 
+ * processus qui projettent le même fichier partagent ses pages.
+ *
+ * L'en-tête, la taille, la somme de contrôle et l'ordre des tableaux sont 
+ * vérifiés en un passage linéaire, sans allocation en dehors de la 
+ * structure renvoyée.
+ *
+ * @param chemin Le chemin du fichier à projeter.
+ * @return L'automate projeté, ou NULL si le fichier ne peut pas être lu ou 
+ *         n'est pas valide.
+ */
+Automate_projete * projeter_automate( const char * chemin );
+
+/**
+ * @brief Libère un automate projeté et sa projection.
+ *
+ * @param automate L'automate à libérer.
+ */
+void liberer_automate_projete( Automate_projete * automate );
+
+/**
+ * @brief Renvoie les états atteints à partir de l'état 'origine' en lisant 
+ *        la lettre 'lettre'.
+ *
+ * Le tableau renvoyé est trié et pointe dans la projection : il ne doit pas
+ * être libéré, et reste valide jusqu'à liberer_automate_projete().
+ *
+ * @param automate Un automate projeté.
+ * @param origine Un état.
+ * @param lettre Une lettre.
+ * @param nb Reçoit le nombre d'états du tableau renvoyé.
+ * @return Les états atteints.
+ */
+const int * delta_projete( 
+	const Automate_projete * automate, int origine, char lettre, int * nb 
+);
+
+/**
+ * @brief Renvoie 1 si le mot est reconnu par l'automate projeté, 0 sinon.
+ *
+ * Le résultat est celui de le_mot_est_reconnu() sur l'automate chargé par 
+ * charger_automate_mmap().
+ *
+ * @param automate Un automate projeté.
+ * @param mot Un mot.
+ */
+int le_mot_est_reconnu_projete( 
+	const Automate_projete * automate, const char * mot 
+);
+
+/**
+ * @brief Charge un automate décrit dans un fichier texte.
+ *
+ * Le fichier contient une instruction par ligne :
+ *  - "etats n" : en-tête facultatif, qui doit être la première instruction 
+ *    du fichier, et qui ajoute les états 0 à n-1 à l'automate ; s'il est 
+ *    présent, tous les états du fichier doivent être compris entre 0 et 
+ *    n-1 ;
+ *  - "initial q" : ajoute l'état initial q ;
+ *  - "final q" : ajoute l'état final q ;
+ *  - "origine lettre fin" : ajoute une transition, la lettre étant un unique
+ *    caractère autre qu'un espace.
+ *
+ * Les mots d'une instruction sont séparés par des blancs : "12a3" n'est pas
+ * une transition. Les lignes vides sont ignorées, et un '#' commence un 
+ * commentaire qui court jusqu'à la fin de la ligne (sauf à la place d'une 
+ * lettre).
+ *
+ * Le fichier est projeté en mémoire et analysé directement, sans scanf(),
+ * puis toutes les transitions sont ajoutées en une fois avec 
+ * ajouter_transitions_en_masse().
+ *
+ * La mémoire de l'automate renvoyé est laissée à la charge de 
+ * l'utilisateur.
+ *
+ * @param chemin Le chemin du fichier à lire.
+ * @return L'automate chargé, ou NULL si le fichier ne peut pas être lu ou 
+ *         contient une erreur de syntaxe.
+ */
+Automate * charger_automate_texte( const char * chemin );
+
+#endif
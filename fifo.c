@@ -22,62 +22,116 @@
 #include "outils.h"
 #include "fifo.h"
 
-typedef struct List List;
+#include <string.h>
 
-struct List {
-	List * next;
-	intptr_t element;
-};
+#define CAPACITE_INITIALE_FIFO 16
 
 struct Fifo {
-	List * list;
+	intptr_t * elements;
+	// Toujours une puissance de deux : les indices sont réduits par un masque
+	int capacite;
+	int debut;
+	int taille;
 };
 
-List* allouer_list( List * next, intptr_t element ){
-	List* res = (List*) xmalloc( sizeof(List) );
-	res->next = next;
-	res->element = element;
+Fifo* creer_fifo(){
+	Fifo* res = xmalloc( sizeof(Fifo) );
+	res->elements = xmalloc( CAPACITE_INITIALE_FIFO * sizeof(intptr_t) );
+	res->capacite = CAPACITE_INITIALE_FIFO;
+	res->debut = 0;
+	res->taille = 0;
 	return res;
 }
 
-void liberer_list( List * list ){
-	xfree( list );
+void liberer_fifo( Fifo* file ){
+	xfree( file->elements );
+	xfree( file );
 }
 
-void ajouter_fifo( Fifo* fifo, intptr_t element ){
-	fifo->list = allouer_list( fifo->list, element );
-}
+/*
+ * Agrandit le tableau pour qu'il puisse contenir 'n' éléments. Les éléments
+ * sont recopiés au début du nouveau tableau, dans l'ordre de la file.
+ */
+void reserver_fifo( Fifo* fifo, int n ){
+	if( n <= fifo->capacite ) return;
 
-intptr_t retirer_fifo( Fifo* fifo ){
-	intptr_t res = fifo->list->element;
-	List* tmp = fifo->list;
-	fifo->list = fifo->list->next;
-	liberer_list( tmp );
-	return res;
+	int capacite = fifo->capacite;
+	while( capacite < n ){
+		capacite *= 2;
+	}
+	intptr_t * elements = xmalloc( capacite * sizeof(intptr_t) );
+	int fin_du_tableau = fifo->capacite - fifo->debut;
+	if( fifo->taille <= fin_du_tableau ){
+		memcpy( 
+			elements, fifo->elements + fifo->debut, 
+			fifo->taille * sizeof(intptr_t) 
+		);
+	}else{
+		memcpy( 
+			elements, fifo->elements + fifo->debut, 
+			fin_du_tableau * sizeof(intptr_t) 
+		);
+		memcpy( 
+			elements + fin_du_tableau, fifo->elements, 
+			( fifo->taille - fin_du_tableau ) * sizeof(intptr_t) 
+		);
+	}
+	xfree( fifo->elements );
+	fifo->elements = elements;
+	fifo->capacite = capacite;
+	fifo->debut = 0;
 }
 
-intptr_t obtenir_fifo( Fifo* fifo ){
-	return fifo->list->element;
+void ajouter_fifo( Fifo* fifo, intptr_t element ){
+	if( fifo->taille == fifo->capacite ){
+		reserver_fifo( fifo, fifo->taille + 1 );
+	}
+	fifo->elements[ ( fifo->debut + fifo->taille ) & ( fifo->capacite - 1 ) ] = 
+		element;
+	fifo->taille++;
 }
 
-int est_vide( Fifo* fifo ){
-	return fifo->list == NULL;
+void ajouter_fifo_en_masse( Fifo* fifo, const intptr_t * elements, int n ){
+	if( n <= 0 ) return;
+	reserver_fifo( fifo, fifo->taille + n );
+
+	// Les éléments sont recopiés en au plus deux morceaux
+	int fin = ( fifo->debut + fifo->taille ) & ( fifo->capacite - 1 );
+	int premier_morceau = fifo->capacite - fin;
+	if( premier_morceau > n ){
+		premier_morceau = n;
+	}
+	memcpy( 
+		fifo->elements + fin, elements, premier_morceau * sizeof(intptr_t) 
+	);
+	memcpy( 
+		fifo->elements, elements + premier_morceau, 
+		( n - premier_morceau ) * sizeof(intptr_t) 
+	);
+	fifo->taille += n;
 }
 
-Fifo* creer_fifo(){
-	Fifo* res = xmalloc( sizeof(Fifo) );
-	res->list = NULL;
+intptr_t retirer_fifo( Fifo* fifo ){
+	if( fifo->taille == 0 ){
+		ERREUR( "La file est vide" );
+	}
+	intptr_t res = fifo->elements[ fifo->debut ];
+	fifo->debut = ( fifo->debut + 1 ) & ( fifo->capacite - 1 );
+	fifo->taille--;
 	return res;
 }
 
-void vider_list( List * list ){
-	if( list ){
-		vider_list( list->next );
-		xfree( list );
+intptr_t obtenir_fifo( Fifo* fifo ){
+	if( fifo->taille == 0 ){
+		ERREUR( "La file est vide" );
 	}
+	return fifo->elements[ fifo->debut ];
 }
 
-void liberer_fifo( Fifo* file ){
-	vider_list( file->list );
-	xfree( file );
+int est_vide( Fifo* fifo ){
+	return fifo->taille == 0;
+}
+
+int taille_fifo( Fifo* fifo ){
+	return fifo->taille;
 }
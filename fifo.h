@@ -26,9 +26,13 @@
 
 /*
  * Définit le type d'une file first-in first-out contenant des entiers ou 
- * des pointerus vers des stucture plus complexes.
+ * des pointeurs vers des structures plus complexes.
  * La file n'est pas responsable de la mémoire des éléments qui y sont 
  * entreposés.
+ *
+ * Les éléments sont rangés dans un tableau circulaire dont la taille est une
+ * puissance de deux, doublée quand il est plein : l'ajout et le retrait 
+ * sont en temps constant amorti, sans allocation par élément.
  */
 typedef struct Fifo Fifo;
 
@@ -38,8 +42,8 @@ typedef struct Fifo Fifo;
 Fifo* creer_fifo();
 
 /*
- * Supprimme la mémoire associée à la file.
- * La mamoir associée aux élément de la file ne sont pas supprimé.
+ * Supprime la mémoire associée à la file.
+ * La mémoire associée aux éléments de la file n'est pas supprimée.
  */
 void liberer_fifo( Fifo* fifo );
 
@@ -49,18 +53,30 @@ void liberer_fifo( Fifo* fifo );
 int est_vide( Fifo* fifo );
 
 /*
- * Ajoute un élément au dessus de la pile.
+ * Renvoie le nombre d'éléments de la file.
+ */
+int taille_fifo( Fifo* fifo );
+
+/*
+ * Ajoute un élément à la fin de la file.
  */
 void ajouter_fifo( Fifo* fifo, intptr_t element );
 
 /*
- * Retire un élément du dessus de la pile et le renvoie.
+ * Ajoute les n éléments du tableau à la fin de la file, dans l'ordre du 
+ * tableau. Le tableau est agrandi au plus une fois.
+ */
+void ajouter_fifo_en_masse( Fifo* fifo, const intptr_t * elements, int n );
+
+/*
+ * Retire l'élément du début de la file et le renvoie.
  */
 intptr_t retirer_fifo( Fifo* fifo );
 
 /*
- * Renvoie l'élement qui se trouve au dessus de la pile. L'élément n'est pas
- * retiré de la pile.
+ * Renvoie l'élément qui se trouve au début de la file, c'est-à-dire le 
+ * prochain élément renvoyé par retirer_fifo(). L'élément n'est pas retiré de
+ * la file.
  */
 intptr_t obtenir_fifo( Fifo* fifo );
 
@@ -0,0 +1,144 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "interneur.h"
+#include "outils.h"
+
+#include <assert.h>
+#include <string.h>
+
+struct Interneur {
+	// Table de hachage chaînée des représentants
+	Ensemble_interne ** alveoles;
+	int nb_alveoles;
+	// Les représentants, rangés par numéro
+	Ensemble_interne ** representants;
+	int nb_representants;
+	int capacite;
+};
+
+Interneur * creer_interneur(){
+	Interneur * res = xmalloc( sizeof(Interneur) );
+	res->nb_alveoles = 64;
+	res->alveoles = xmalloc( res->nb_alveoles * sizeof(Ensemble_interne*) );
+	memset( res->alveoles, 0, res->nb_alveoles * sizeof(Ensemble_interne*) );
+	res->capacite = 64;
+	res->representants = xmalloc( res->capacite * sizeof(Ensemble_interne*) );
+	res->nb_representants = 0;
+	return res;
+}
+
+void liberer_interneur( Interneur * interneur ){
+	int i;
+	for( i=0; i<interneur->nb_representants; i++ ){
+		liberer_ensemble( (Ensemble*) interneur->representants[i]->ensemble );
+		xfree( interneur->representants[i] );
+	}
+	xfree( interneur->representants );
+	xfree( interneur->alveoles );
+	xfree( interneur );
+}
+
+/*
+ * Double le nombre d'alvéoles de la table de hachage.
+ */
+void agrandir_interneur( Interneur * interneur ){
+	int nb_alveoles = 2 * interneur->nb_alveoles;
+	Ensemble_interne ** alveoles = xmalloc( nb_alveoles * sizeof(Ensemble_interne*) );
+	memset( alveoles, 0, nb_alveoles * sizeof(Ensemble_interne*) );
+	int i;
+	for( i=0; i<interneur->nb_representants; i++ ){
+		Ensemble_interne * representant = interneur->representants[i];
+		int j = representant->hash % nb_alveoles;
+		representant->suivant = alveoles[j];
+		alveoles[j] = representant;
+	}
+	xfree( interneur->alveoles );
+	interneur->alveoles = alveoles;
+	interneur->nb_alveoles = nb_alveoles;
+}
+
+Ensemble_interne * chercher_representant( 
+	const Interneur * interneur, const Ensemble * ensemble, uint64_t hash 
+){
+	Ensemble_interne * representant = 
+		interneur->alveoles[ hash % interneur->nb_alveoles ];
+	while( representant ){
+		if( ensembles_egaux( representant->ensemble, ensemble ) ){
+			return representant;
+		}
+		representant = representant->suivant;
+	}
+	return NULL;
+}
+
+const Ensemble_interne * trouver_ensemble_interne( 
+	const Interneur * interneur, const Ensemble * ensemble 
+){
+	return chercher_representant( 
+		interneur, ensemble, hash_ensemble( ensemble ) 
+	);
+}
+
+const Ensemble_interne * interner_ensemble( 
+	Interneur * interneur, Ensemble * ensemble, int * nouveau 
+){
+	uint64_t hash = hash_ensemble( ensemble );
+	Ensemble_interne * representant = 
+		chercher_representant( interneur, ensemble, hash );
+	if( representant ){
+		liberer_ensemble( ensemble );
+		if( nouveau ) *nouveau = 0;
+		return representant;
+	}
+
+	if( interneur->nb_representants >= interneur->nb_alveoles ){
+		agrandir_interneur( interneur );
+	}
+	if( interneur->nb_representants == interneur->capacite ){
+		interneur->capacite *= 2;
+		interneur->representants = xrealloc( 
+			interneur->representants, 
+			interneur->capacite * sizeof(Ensemble_interne*) 
+		);
+	}
+	representant = xmalloc( sizeof(Ensemble_interne) );
+	representant->ensemble = ensemble;
+	representant->hash = hash;
+	representant->numero = interneur->nb_representants;
+	int j = hash % interneur->nb_alveoles;
+	representant->suivant = interneur->alveoles[j];
+	interneur->alveoles[j] = representant;
+	interneur->representants[ interneur->nb_representants++ ] = representant;
+	if( nouveau ) *nouveau = 1;
+	return representant;
+}
+
+int nombre_ensembles_internes( const Interneur * interneur ){
+	return interneur->nb_representants;
+}
+
+const Ensemble_interne * ensemble_interne_numero( 
+	const Interneur * interneur, int numero 
+){
+	assert( numero >= 0 && numero < interneur->nb_representants );
+	return interneur->representants[numero];
+}
@@ -0,0 +1,97 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef __INTERNEUR_H__
+#define __INTERNEUR_H__
+
+#include <stdint.h>
+
+#include "ensemble.h"
+
+/*
+ * Un interneur associe à chaque ensemble d'entiers un unique représentant 
+ * canonique : deux ensembles égaux, internés dans le même interneur, ont le
+ * même représentant. L'égalité de deux ensembles internés se teste donc en 
+ * comparant deux pointeurs, et chaque représentant porte l'empreinte de son
+ * ensemble, calculée une seule fois, ainsi qu'un numéro.
+ *
+ * Les ensembles internés appartiennent à l'interneur et ne doivent plus être 
+ * modifiés.
+ */
+typedef struct Interneur Interneur;
+
+/*
+ * Le représentant canonique d'un ensemble interné.
+ */
+typedef struct Ensemble_interne {
+	const Ensemble * ensemble;
+	uint64_t hash;
+	// Numéro du représentant, de 0 à n-1 dans l'ordre de création
+	int numero;
+	struct Ensemble_interne * suivant;
+} Ensemble_interne;
+
+/*
+ * Crée un interneur vide.
+ */
+Interneur * creer_interneur();
+
+/*
+ * Libère l'interneur, ainsi que tous les ensembles internés.
+ */
+void liberer_interneur( Interneur * interneur );
+
+/*
+ * Renvoie le représentant canonique de l'ensemble passé en paramètre.
+ *
+ * L'interneur devient responsable de la mémoire de l'ensemble : si un 
+ * ensemble égal a déjà été interné, l'ensemble est libéré et le représentant
+ * existant est renvoyé ; sinon, un nouveau représentant est créé pour 
+ * l'ensemble, avec le numéro suivant. Dans ce cas, '*nouveau' est mis à 1 si 
+ * 'nouveau' n'est pas NULL.
+ */
+const Ensemble_interne * interner_ensemble( 
+	Interneur * interneur, Ensemble * ensemble, int * nouveau 
+);
+
+/*
+ * Renvoie le représentant canonique d'un ensemble égal à l'ensemble passé en
+ * paramètre, ou NULL si aucun ensemble égal n'a été interné. L'ensemble 
+ * n'est pas modifié.
+ */
+const Ensemble_interne * trouver_ensemble_interne( 
+	const Interneur * interneur, const Ensemble * ensemble 
+);
+
+/*
+ * Renvoie le nombre d'ensembles internés.
+ */
+int nombre_ensembles_internes( const Interneur * interneur );
+
+/*
+ * Renvoie le représentant de numéro 'numero'.
+ */
+const Ensemble_interne * ensemble_interne_numero( 
+	const Interneur * interneur, int numero 
+);
+
+#endif
@@ -21,7 +21,18 @@
 
 #include "outils.h"
 
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+// Les définitions de ce fichier ne doivent pas être remplacées par les 
+// macros de l'instrumentation.
+#undef xmalloc
+#undef xrealloc
+#undef xfree
 
 int test( int result, int ligne ){
 	if( ! result ){
@@ -31,6 +42,8 @@ int test( int result, int ligne ){
 	return 0;
 }
 
+#ifndef INSTRUMENTER_ALLOCATIONS
+
 void* xmalloc( size_t n ){
 	void* result = malloc( n );
 	if( ! result ){
@@ -39,6 +52,340 @@ void* xmalloc( size_t n ){
 	return result;
 }
 
+void* xrealloc( void* ptr, size_t n ){
+	void* result = realloc( ptr, n );
+	if( ! result ){
+		ERREUR( "Espace insuffisant" );
+	}
+	return result;
+}
+
 void xfree( void* ptr ){
 	free(ptr);
 }
+
+void* xmalloc_instrumente( size_t n, const char * site ){
+	return xmalloc( n );
+}
+
+void* xrealloc_instrumente( void* ptr, size_t n, const char * site ){
+	return xrealloc( ptr, n );
+}
+
+void xfree_instrumente( void* ptr, const char * site ){
+	xfree( ptr );
+}
+
+int activer_instrumentation_allocations( int actif ){
+	return 0;
+}
+
+void reinitialiser_instrumentation_allocations(){
+}
+
+void statistiques_allocations( Statistiques_allocations * stats ){
+	memset( stats, 0, sizeof(Statistiques_allocations) );
+}
+
+int statistiques_allocations_site( 
+	const char * fonction, Statistiques_allocations * stats 
+){
+	memset( stats, 0, sizeof(Statistiques_allocations) );
+	return 0;
+}
+
+size_t histogramme_allocations( int classe ){
+	return 0;
+}
+
+void afficher_instrumentation_allocations( FILE * sortie ){
+	fprintf( 
+		sortie, 
+		"Instrumentation des allocations non compilée "
+		"(voir INSTRUMENTER_ALLOCATIONS).\n" 
+	);
+}
+
+#else
+
+/*
+ * L'en-tête placé devant chaque bloc. Sa taille est un multiple de 
+ * l'alignement maximal, pour que le bloc rendu reste bien aligné.
+ */
+typedef union En_tete_allocation {
+	struct {
+		size_t taille;
+		// -1 si le bloc a été alloué alors que l'instrumentation était 
+		// désactivée
+		int site;
+		unsigned int generation;
+	} info;
+	max_align_t alignement;
+} En_tete_allocation;
+
+typedef struct Site_allocation {
+	const char * nom;
+	Statistiques_allocations stats;
+} Site_allocation;
+
+// Les sites sont rangés par adresse de __func__ ; le dernier regroupe les 
+// sites qui n'ont plus de place.
+#define SITE_AUTRES ( NB_SITES_ALLOCATION - 1 )
+
+static pthread_mutex_t verrou_allocations = PTHREAD_MUTEX_INITIALIZER;
+static atomic_int instrumentation_active = 0;
+static int bilan_programme = 0;
+static unsigned int generation_allocations = 0;
+static Site_allocation sites_allocation[NB_SITES_ALLOCATION];
+static Statistiques_allocations total_allocations;
+static size_t classes_tailles[NB_CLASSES_TAILLES];
+
+int classe_de_taille( size_t n ){
+	int classe = 0;
+	while( n ){
+		classe++;
+		n >>= 1;
+	}
+	return classe < NB_CLASSES_TAILLES ? classe : NB_CLASSES_TAILLES - 1;
+}
+
+/*
+ * Renvoie l'indice du site de la fonction 'nom', en le créant si besoin.
+ * Doit être appelée avec le verrou.
+ */
+int trouver_site_allocation( const char * nom ){
+	size_t debut = ( (uintptr_t) nom >> 3 ) % SITE_AUTRES;
+	int i;
+	for( i=0; i < SITE_AUTRES; i++ ){
+		int j = ( debut + i ) % SITE_AUTRES;
+		if( sites_allocation[j].nom == nom ){
+			return j;
+		}
+		if( sites_allocation[j].nom == NULL ){
+			sites_allocation[j].nom = nom;
+			return j;
+		}
+	}
+	sites_allocation[SITE_AUTRES].nom = "(autres sites)";
+	return SITE_AUTRES;
+}
+
+void compter_allocation( Statistiques_allocations * stats, size_t n ){
+	stats->nb_allocations++;
+	stats->octets_alloues += n;
+	stats->octets_vivants += n;
+	if( stats->octets_vivants > stats->pic_octets_vivants ){
+		stats->pic_octets_vivants = stats->octets_vivants;
+	}
+}
+
+void compter_liberation( Statistiques_allocations * stats, size_t n ){
+	stats->nb_liberations++;
+	stats->octets_vivants -= n;
+}
+
+/*
+ * Compte le bloc s'il vient d'être alloué par 'site' alors que 
+ * l'instrumentation est active.
+ */
+void enregistrer_allocation( En_tete_allocation * bloc, const char * site ){
+	bloc->info.site = -1;
+	if( ! atomic_load( &instrumentation_active ) ) return;
+
+	pthread_mutex_lock( &verrou_allocations );
+	bloc->info.site = trouver_site_allocation( site );
+	bloc->info.generation = generation_allocations;
+	compter_allocation( 
+		&sites_allocation[bloc->info.site].stats, bloc->info.taille 
+	);
+	compter_allocation( &total_allocations, bloc->info.taille );
+	classes_tailles[ classe_de_taille( bloc->info.taille ) ]++;
+	pthread_mutex_unlock( &verrou_allocations );
+}
+
+/*
+ * Décompte le bloc, même si l'instrumentation a été désactivée depuis son
+ * allocation. La libération est attribuée au site qui a alloué le bloc.
+ */
+void enregistrer_liberation( const En_tete_allocation * bloc ){
+	if( bloc->info.site < 0 ) return;
+
+	pthread_mutex_lock( &verrou_allocations );
+	if( bloc->info.generation == generation_allocations ){
+		compter_liberation( 
+			&sites_allocation[bloc->info.site].stats, bloc->info.taille 
+		);
+		compter_liberation( &total_allocations, bloc->info.taille );
+	}
+	pthread_mutex_unlock( &verrou_allocations );
+}
+
+void* xmalloc_instrumente( size_t n, const char * site ){
+	En_tete_allocation * bloc = malloc( sizeof(En_tete_allocation) + n );
+	if( ! bloc ){
+		ERREUR( "Espace insuffisant" );
+	}
+	bloc->info.taille = n;
+	enregistrer_allocation( bloc, site );
+	return bloc + 1;
+}
+
+void* xrealloc_instrumente( void* ptr, size_t n, const char * site ){
+	if( ! ptr ){
+		return xmalloc_instrumente( n, site );
+	}
+	En_tete_allocation * bloc = (En_tete_allocation *) ptr - 1;
+	enregistrer_liberation( bloc );
+	bloc = realloc( bloc, sizeof(En_tete_allocation) + n );
+	if( ! bloc ){
+		ERREUR( "Espace insuffisant" );
+	}
+	bloc->info.taille = n;
+	enregistrer_allocation( bloc, site );
+	return bloc + 1;
+}
+
+void xfree_instrumente( void* ptr, const char * site ){
+	if( ! ptr ) return;
+	En_tete_allocation * bloc = (En_tete_allocation *) ptr - 1;
+	enregistrer_liberation( bloc );
+	free( bloc );
+}
+
+// Appels compilés sans INSTRUMENTER_ALLOCATIONS : le site est inconnu.
+void* xmalloc( size_t n ){
+	return xmalloc_instrumente( n, "xmalloc" );
+}
+
+void* xrealloc( void* ptr, size_t n ){
+	return xrealloc_instrumente( ptr, n, "xrealloc" );
+}
+
+void xfree( void* ptr ){
+	xfree_instrumente( ptr, "xfree" );
+}
+
+void afficher_bilan_allocations(){
+	afficher_instrumentation_allocations( stderr );
+}
+
+int activer_instrumentation_allocations( int actif ){
+	pthread_mutex_lock( &verrou_allocations );
+	if( actif && ! bilan_programme ){
+		atexit( afficher_bilan_allocations );
+		bilan_programme = 1;
+	}
+	atomic_store( &instrumentation_active, actif != 0 );
+	pthread_mutex_unlock( &verrou_allocations );
+	return 1;
+}
+
+void reinitialiser_instrumentation_allocations(){
+	pthread_mutex_lock( &verrou_allocations );
+	generation_allocations++;
+	memset( sites_allocation, 0, sizeof(sites_allocation) );
+	memset( &total_allocations, 0, sizeof(total_allocations) );
+	memset( classes_tailles, 0, sizeof(classes_tailles) );
+	pthread_mutex_unlock( &verrou_allocations );
+}
+
+void statistiques_allocations( Statistiques_allocations * stats ){
+	pthread_mutex_lock( &verrou_allocations );
+	*stats = total_allocations;
+	pthread_mutex_unlock( &verrou_allocations );
+}
+
+int statistiques_allocations_site( 
+	const char * fonction, Statistiques_allocations * stats 
+){
+	int trouve = 0;
+	pthread_mutex_lock( &verrou_allocations );
+	int i;
+	for( i=0; i<NB_SITES_ALLOCATION; i++ ){
+		if( 
+			sites_allocation[i].nom 
+			&& strcmp( sites_allocation[i].nom, fonction ) == 0 
+		){
+			*stats = sites_allocation[i].stats;
+			trouve = 1;
+			break;
+		}
+	}
+	pthread_mutex_unlock( &verrou_allocations );
+	if( ! trouve ){
+		memset( stats, 0, sizeof(Statistiques_allocations) );
+	}
+	return trouve;
+}
+
+size_t histogramme_allocations( int classe ){
+	if( classe < 0 || classe >= NB_CLASSES_TAILLES ) return 0;
+	pthread_mutex_lock( &verrou_allocations );
+	size_t res = classes_tailles[classe];
+	pthread_mutex_unlock( &verrou_allocations );
+	return res;
+}
+
+int comparer_sites_allocation( const void* a, const void* b ){
+	const Site_allocation * s1 = (const Site_allocation *) a;
+	const Site_allocation * s2 = (const Site_allocation *) b;
+	if( s1->stats.octets_alloues != s2->stats.octets_alloues ){
+		return s1->stats.octets_alloues > s2->stats.octets_alloues ? -1 : 1;
+	}
+	return strcmp( s1->nom, s2->nom );
+}
+
+void afficher_instrumentation_allocations( FILE * sortie ){
+	Site_allocation sites[NB_SITES_ALLOCATION];
+	size_t classes[NB_CLASSES_TAILLES];
+	Statistiques_allocations total;
+	int nb_sites = 0;
+	int i;
+
+	// Les compteurs sont recopiés pour ne pas écrire avec le verrou
+	pthread_mutex_lock( &verrou_allocations );
+	for( i=0; i<NB_SITES_ALLOCATION; i++ ){
+		if( sites_allocation[i].nom ){
+			sites[nb_sites++] = sites_allocation[i];
+		}
+	}
+	memcpy( classes, classes_tailles, sizeof(classes) );
+	total = total_allocations;
+	pthread_mutex_unlock( &verrou_allocations );
+
+	qsort( sites, nb_sites, sizeof(Site_allocation), comparer_sites_allocation );
+
+	fprintf( 
+		sortie, 
+		"Allocations : %zu, libérations : %zu, octets alloués : %zu, "
+		"octets vivants : %zu, pic : %zu\n",
+		total.nb_allocations, total.nb_liberations, total.octets_alloues,
+		total.octets_vivants, total.pic_octets_vivants
+	);
+	fprintf( 
+		sortie, "%-32s %12s %12s %14s %12s %12s\n", 
+		"site", "allocations", "libérations", "octets", "vivants", "pic" 
+	);
+	for( i=0; i<nb_sites; i++ ){
+		const Statistiques_allocations * s = &sites[i].stats;
+		fprintf(
+			sortie, "%-32s %12zu %12zu %14zu %12zu %12zu\n", sites[i].nom,
+			s->nb_allocations, s->nb_liberations, s->octets_alloues,
+			s->octets_vivants, s->pic_octets_vivants
+		);
+	}
+	fprintf( sortie, "Tailles des allocations :\n" );
+	if( classes[0] ){
+		fprintf( sortie, "  %21s : %zu\n", "0", classes[0] );
+	}
+	for( i=1; i<NB_CLASSES_TAILLES; i++ ){
+		if( classes[i] ){
+			fprintf( 
+				sortie, "  [2^%-2d, 2^%-2d[ octets : %zu\n", 
+				i-1, i, classes[i] 
+			);
+		}
+	}
+}
+
+#endif
@@ -30,8 +30,86 @@
 #define ERREUR(x) do { fprintf(stderr,"ERREUR : %s - ligne : %d, fichier : %s\n", (x), __LINE__, __FILE__ ); exit(EXIT_FAILURE); } while(0)
 
 void* xmalloc( size_t n );
+void* xrealloc( void* ptr, size_t n );
 void xfree( void* ptr );
 
+/*
+ * Instrumentation des allocations.
+ *
+ * Lorsque la bibliothèque et le code qui l'utilise sont compilés avec 
+ * -DINSTRUMENTER_ALLOCATIONS (voir la cible 'checkalloc' du makefile), 
+ * xmalloc(), xrealloc() et xfree() transmettent le nom de la fonction 
+ * appelante (__func__). Une fois l'instrumentation activée, chaque fonction
+ * est un site dont on compte les allocations, les libérations, les octets 
+ * alloués, les octets encore vivants et leur pic. Un histogramme des tailles
+ * (par puissance de deux) est tenu pour l'ensemble des allocations.
+ *
+ * Chaque bloc est alors précédé d'un en-tête qui retient sa taille et son 
+ * site. Les compteurs sont protégés par un mutex.
+ *
+ * Sans la macro, les fonctions ci-dessous existent mais ne font rien.
+ */
+#define NB_SITES_ALLOCATION 256
+#define NB_CLASSES_TAILLES 33
+
+typedef struct Statistiques_allocations {
+	size_t nb_allocations;
+	size_t nb_liberations;
+	size_t octets_alloues;
+	size_t octets_vivants;
+	size_t pic_octets_vivants;
+} Statistiques_allocations;
+
+void* xmalloc_instrumente( size_t n, const char * site );
+void* xrealloc_instrumente( void* ptr, size_t n, const char * site );
+void xfree_instrumente( void* ptr, const char * site );
+
+#ifdef INSTRUMENTER_ALLOCATIONS
+#define xmalloc(n) xmalloc_instrumente( (n), __func__ )
+#define xrealloc(ptr,n) xrealloc_instrumente( (ptr), (n), __func__ )
+#define xfree(ptr) xfree_instrumente( (ptr), __func__ )
+#endif
+
+/*
+ * Active (actif != 0) ou désactive le comptage des allocations. À la 
+ * première activation, le bilan est programmé pour être affiché sur stderr 
+ * à la fin du programme (atexit()).
+ * Renvoie 1 si l'instrumentation est compilée, 0 sinon.
+ */
+int activer_instrumentation_allocations( int actif );
+
+/*
+ * Remet tous les compteurs à zéro. Les blocs encore vivants ne seront pas 
+ * décomptés à leur libération.
+ */
+void reinitialiser_instrumentation_allocations();
+
+/*
+ * Renvoie dans 'stats' les compteurs de toutes les allocations.
+ */
+void statistiques_allocations( Statistiques_allocations * stats );
+
+/*
+ * Renvoie dans 'stats' les compteurs des allocations faites par la fonction
+ * 'fonction'. Renvoie 1 si la fonction a fait des allocations, 0 sinon.
+ */
+int statistiques_allocations_site( 
+	const char * fonction, Statistiques_allocations * stats 
+);
+
+/*
+ * Renvoie le nombre d'allocations dont la taille est dans la classe 'classe'
+ * de l'histogramme : la classe 0 compte les allocations de 0 octet, et la 
+ * classe k > 0 celles de 2^(k-1) à 2^k - 1 octets.
+ */
+size_t histogramme_allocations( int classe );
+
+/*
+ * Affiche le bilan : les totaux, les sites triés par octets alloués, puis 
+ * l'histogramme des tailles.
+ */
+void afficher_instrumentation_allocations( FILE * sortie );
+
 #define TEST(y,x) do { x &= (y); if(!(y)){ fprintf(stdout, "\033[31mEchec du test %s() -- ligne : %d, fichier : %s\033[0m\n", __FUNCTION__, __LINE__, __FILE__ ); } } while(0)
 #define TEST1(x) test( x, __LINE__)
 
@@ -0,0 +1,571 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "parcours_parallele.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * Le graphe des transitions, sans les lettres, dans un format compact : les 
+ * voisins du sommet i sont voisins[ debuts[i] ] ... voisins[ debuts[i+1]-1 ].
+ */
+typedef struct {
+	int n;
+	size_t * debuts;
+	int * voisins;
+} Graphe_compact;
+
+/*
+ * Les états de l'automate, numérotés de 0 à nb_etats-1 dans l'ordre 
+ * croissant. Si les états sont consécutifs, le numéro d'un état est 
+ * simplement son écart au plus petit état.
+ */
+typedef struct {
+	const int * etats;
+	int nb_etats;
+	int consecutifs;
+} Numerotation;
+
+static inline int indice_etat( const Numerotation * numerotation, int etat ){
+	if( numerotation->consecutifs ){
+		return etat - numerotation->etats[0];
+	}
+	int debut = 0;
+	int fin = numerotation->nb_etats - 1;
+	while( debut < fin ){
+		int milieu = debut + ( fin - debut ) / 2;
+		if( numerotation->etats[milieu] < etat ){
+			debut = milieu + 1;
+		}else{
+			fin = milieu;
+		}
+	}
+	return debut;
+}
+
+/*
+ * Construction du graphe des successeurs en un seul passage sur les 
+ * transitions : elles sont parcourues dans l'ordre des clés (origine, 
+ * lettre), donc par origine croissante, et l'indice de l'origine s'obtient
+ * en avançant dans le tableau trié des états. Les états d'arrivée sont 
+ * rangés tels quels, puis numérotés ensuite en parallèle.
+ */
+typedef struct {
+	const Numerotation * numerotation;
+	Graphe_compact * successeurs;
+	size_t capacite;
+	int origine; // Indice de la dernière origine rencontrée
+} Construction_graphe;
+
+void action_ajouter_successeur( int origine, char lettre, int fin, void* data ){
+	Construction_graphe * construction = (Construction_graphe *) data;
+	Graphe_compact * graphe = construction->successeurs;
+	const int * etats = construction->numerotation->etats;
+	size_t nb = graphe->debuts[ construction->origine + 1 ];
+	while( etats[ construction->origine ] != origine ){
+		construction->origine++;
+		graphe->debuts[ construction->origine + 1 ] = nb;
+	}
+	if( nb == construction->capacite ){
+		construction->capacite *= 2;
+		graphe->voisins = xrealloc( 
+			graphe->voisins, construction->capacite * sizeof(int) 
+		);
+	}
+	graphe->voisins[nb] = fin;
+	graphe->debuts[ construction->origine + 1 ] = nb + 1;
+}
+
+typedef struct {
+	const Numerotation * numerotation;
+	int * voisins;
+	size_t debut;
+	size_t fin;
+} Numerotation_voisins;
+
+void * numeroter_voisins( void * data ){
+	Numerotation_voisins * tranche = (Numerotation_voisins *) data;
+	size_t i;
+	for( i=tranche->debut; i<tranche->fin; i++ ){
+		tranche->voisins[i] = indice_etat( 
+			tranche->numerotation, tranche->voisins[i] 
+		);
+	}
+	return NULL;
+}
+
+/*
+ * En dessous de ce nombre de transitions par thread, les états d'arrivée 
+ * sont numérotés sans créer de threads.
+ */
+#define TRANSITIONS_PAR_THREAD 65536
+
+/*
+ * Remplace chaque état d'arrivée par son numéro, en répartissant les 
+ * transitions entre les threads.
+ */
+void numeroter_successeurs( 
+	Graphe_compact * successeurs, const Numerotation * numerotation, 
+	int nb_threads 
+){
+	size_t nb = successeurs->debuts[ successeurs->n ];
+	if( (size_t) nb_threads > nb / TRANSITIONS_PAR_THREAD ){
+		nb_threads = nb / TRANSITIONS_PAR_THREAD;
+	}
+	if( nb_threads <= 1 ){
+		Numerotation_voisins tout = { numerotation, successeurs->voisins, 0, nb };
+		numeroter_voisins( &tout );
+		return;
+	}
+	Numerotation_voisins * tranches = 
+		xmalloc( nb_threads * sizeof(Numerotation_voisins) );
+	pthread_t * identifiants = xmalloc( nb_threads * sizeof(pthread_t) );
+	int i;
+	for( i=0; i<nb_threads; i++ ){
+		tranches[i].numerotation = numerotation;
+		tranches[i].voisins = successeurs->voisins;
+		tranches[i].debut = nb * i / nb_threads;
+		tranches[i].fin = nb * ( i + 1 ) / nb_threads;
+		if( pthread_create( &identifiants[i], NULL, numeroter_voisins, &tranches[i] ) ){
+			ERREUR( "Impossible de créer un thread" );
+		}
+	}
+	for( i=0; i<nb_threads; i++ ){
+		pthread_join( identifiants[i], NULL );
+	}
+	xfree( identifiants );
+	xfree( tranches );
+}
+
+/*
+ * Construit le graphe des successeurs (déjà numéroté) de l'automate.
+ */
+void construire_successeurs( 
+	const Automate * automate, const Numerotation * numerotation, 
+	Graphe_compact * successeurs, int nb_threads 
+){
+	int n = numerotation->nb_etats;
+	successeurs->n = n;
+	successeurs->debuts = xmalloc( ( n + 1 ) * sizeof(size_t) );
+	successeurs->debuts[0] = 0;
+	successeurs->voisins = xmalloc( 64 * sizeof(int) );
+	if( n > 0 ){
+		successeurs->debuts[1] = 0;
+		Construction_graphe construction = { numerotation, successeurs, 64, 0 };
+		pour_toute_transition( automate, action_ajouter_successeur, &construction );
+		// Les derniers états n'ont pas de successeurs
+		int i;
+		for( i = construction.origine + 1; i < n; i++ ){
+			successeurs->debuts[i+1] = successeurs->debuts[i];
+		}
+	}
+	numeroter_successeurs( successeurs, numerotation, nb_threads );
+}
+
+/*
+ * Construit le graphe inverse par un tri par dénombrement des arcs, sans 
+ * aucune recherche. Les prédécesseurs de chaque sommet sont rangés dans 
+ * l'ordre croissant.
+ */
+void construire_predecesseurs( 
+	const Graphe_compact * successeurs, Graphe_compact * predecesseurs 
+){
+	int n = successeurs->n;
+	size_t nb = successeurs->debuts[n];
+	int i;
+	size_t j;
+	predecesseurs->n = n;
+	predecesseurs->debuts = xmalloc( ( n + 1 ) * sizeof(size_t) );
+	memset( predecesseurs->debuts, 0, ( n + 1 ) * sizeof(size_t) );
+	for( j=0; j<nb; j++ ){
+		predecesseurs->debuts[ successeurs->voisins[j] + 1 ]++;
+	}
+	for( i=0; i<n; i++ ){
+		predecesseurs->debuts[i+1] += predecesseurs->debuts[i];
+	}
+	predecesseurs->voisins = xmalloc( ( nb + 1 ) * sizeof(int) );
+	size_t * positions = xmalloc( ( n + 1 ) * sizeof(size_t) );
+	memcpy( positions, predecesseurs->debuts, ( n + 1 ) * sizeof(size_t) );
+	for( i=0; i<n; i++ ){
+		for( j=successeurs->debuts[i]; j<successeurs->debuts[i+1]; j++ ){
+			predecesseurs->voisins[ positions[ successeurs->voisins[j] ]++ ] = i;
+		}
+	}
+	xfree( positions );
+}
+
+void liberer_graphe_compact( Graphe_compact * graphe ){
+	xfree( graphe->debuts );
+	xfree( graphe->voisins );
+}
+
+/*
+ * Tampon d'états découverts par un thread pendant un niveau.
+ */
+typedef struct {
+	int * elements;
+	int taille;
+	int capacite;
+	long long degres; // Somme des degrés sortants des états du tampon
+} Tampon_parcours;
+
+void ajouter_tampon_parcours( Tampon_parcours * tampon, int element ){
+	if( tampon->taille == tampon->capacite ){
+		tampon->capacite = tampon->capacite ? 2 * tampon->capacite : 256;
+		tampon->elements = xrealloc( 
+			tampon->elements, tampon->capacite * sizeof(int) 
+		);
+	}
+	tampon->elements[ tampon->taille++ ] = element;
+}
+
+/*
+ * Une étape « bottom-up » est faite quand les transitions issues de la 
+ * frontière sont plus nombreuses que celles des états non visités divisées
+ * par ALPHA_PARCOURS ; on revient aux étapes « top-down » quand la 
+ * frontière a moins de n / BETA_PARCOURS états.
+ */
+#define ALPHA_PARCOURS 14
+#define BETA_PARCOURS 24
+
+#define BITS_PAR_MOT 64
+
+typedef struct {
+	// Graphe parcouru, et graphe inverse pour les étapes « bottom-up »
+	const Graphe_compact * avant;
+	const Graphe_compact * arriere;
+	int nb_threads;
+	int nb_mots;
+	_Atomic uint64_t * visites;
+	_Atomic uint64_t * dans_frontiere;
+	int * frontiere;
+	int taille_frontiere;
+	int bottom_up;
+	int fini;
+	long long degres_non_visites;
+	Tampon_parcours * tampons;
+	int * decalages;
+	pthread_barrier_t barriere;
+} Parcours_parallele;
+
+typedef struct {
+	Parcours_parallele * parcours;
+	int numero;
+} Thread_parcours;
+
+int est_visite( Parcours_parallele * parcours, int sommet ){
+	uint64_t mot = atomic_load_explicit( 
+		&parcours->visites[ sommet / BITS_PAR_MOT ], memory_order_relaxed 
+	);
+	return ( mot >> ( sommet % BITS_PAR_MOT ) ) & 1;
+}
+
+/*
+ * Marque un sommet comme visité. Renvoie 1 si ce thread est le premier à 
+ * le faire.
+ */
+int visiter( Parcours_parallele * parcours, int sommet ){
+	uint64_t bit = (uint64_t) 1 << ( sommet % BITS_PAR_MOT );
+	uint64_t ancien = atomic_fetch_or_explicit( 
+		&parcours->visites[ sommet / BITS_PAR_MOT ], bit, memory_order_relaxed 
+	);
+	return ! ( ancien & bit );
+}
+
+void etape_top_down( Parcours_parallele * parcours, Tampon_parcours * tampon, int numero ){
+	const Graphe_compact * graphe = parcours->avant;
+	long long debut = (long long) parcours->taille_frontiere * numero / parcours->nb_threads;
+	long long fin = (long long) parcours->taille_frontiere * ( numero + 1 ) / parcours->nb_threads;
+	long long i;
+	size_t j;
+	for( i=debut; i<fin; i++ ){
+		int sommet = parcours->frontiere[i];
+		for( j=graphe->debuts[sommet]; j<graphe->debuts[sommet+1]; j++ ){
+			int voisin = graphe->voisins[j];
+			if( ! est_visite( parcours, voisin ) && visiter( parcours, voisin ) ){
+				ajouter_tampon_parcours( tampon, voisin );
+				tampon->degres += graphe->debuts[voisin+1] - graphe->debuts[voisin];
+			}
+		}
+	}
+}
+
+void etape_bottom_up( Parcours_parallele * parcours, Tampon_parcours * tampon, int numero ){
+	const Graphe_compact * graphe = parcours->arriere;
+	// Chaque thread traite des mots entiers des tableaux de bits
+	int premier_mot = (long long) parcours->nb_mots * numero / parcours->nb_threads;
+	int dernier_mot = (long long) parcours->nb_mots * ( numero + 1 ) / parcours->nb_threads;
+	int debut = premier_mot * BITS_PAR_MOT;
+	int fin = dernier_mot * BITS_PAR_MOT;
+	if( fin > graphe->n ){
+		fin = graphe->n;
+	}
+	int sommet;
+	size_t j;
+	for( sommet=debut; sommet<fin; sommet++ ){
+		if( est_visite( parcours, sommet ) ){
+			continue;
+		}
+		for( j=graphe->debuts[sommet]; j<graphe->debuts[sommet+1]; j++ ){
+			int voisin = graphe->voisins[j];
+			uint64_t mot = atomic_load_explicit( 
+				&parcours->dans_frontiere[ voisin / BITS_PAR_MOT ], 
+				memory_order_relaxed 
+			);
+			if( ( mot >> ( voisin % BITS_PAR_MOT ) ) & 1 ){
+				visiter( parcours, sommet );
+				ajouter_tampon_parcours( tampon, sommet );
+				tampon->degres += parcours->avant->debuts[sommet+1] 
+					- parcours->avant->debuts[sommet];
+				break;
+			}
+		}
+	}
+}
+
+/*
+ * Prépare le niveau suivant, une fois que tous les threads ont rempli leurs
+ * tampons. Exécuté par un seul thread.
+ */
+void preparer_niveau_suivant( Parcours_parallele * parcours ){
+	int i;
+	int taille = 0;
+	long long degres = 0;
+	for( i=0; i<parcours->nb_threads; i++ ){
+		parcours->decalages[i] = taille;
+		taille += parcours->tampons[i].taille;
+		degres += parcours->tampons[i].degres;
+	}
+	parcours->taille_frontiere = taille;
+	parcours->degres_non_visites -= degres;
+	parcours->fini = ( taille == 0 );
+	if( ! parcours->bottom_up ){
+		parcours->bottom_up = 
+			degres * ALPHA_PARCOURS > parcours->degres_non_visites;
+	}else{
+		parcours->bottom_up = 
+			(long long) taille * BETA_PARCOURS >= parcours->avant->n;
+	}
+}
+
+void * parcourir( void * data ){
+	Thread_parcours * thread = (Thread_parcours *) data;
+	Parcours_parallele * parcours = thread->parcours;
+	Tampon_parcours * tampon = &parcours->tampons[ thread->numero ];
+	int premier_mot = (long long) parcours->nb_mots * thread->numero / parcours->nb_threads;
+	int dernier_mot = (long long) parcours->nb_mots * ( thread->numero + 1 ) / parcours->nb_threads;
+	int i;
+
+	while( 1 ){
+		tampon->taille = 0;
+		tampon->degres = 0;
+		if( parcours->bottom_up ){
+			etape_bottom_up( parcours, tampon, thread->numero );
+		}else{
+			etape_top_down( parcours, tampon, thread->numero );
+		}
+		if( pthread_barrier_wait( &parcours->barriere ) == PTHREAD_BARRIER_SERIAL_THREAD ){
+			preparer_niveau_suivant( parcours );
+		}
+		pthread_barrier_wait( &parcours->barriere );
+		if( parcours->fini ){
+			break;
+		}
+		// La nouvelle frontière : d'abord le tableau de bits est vidé ...
+		for( i=premier_mot; i<dernier_mot; i++ ){
+			atomic_store_explicit( 
+				&parcours->dans_frontiere[i], 0, memory_order_relaxed 
+			);
+		}
+		pthread_barrier_wait( &parcours->barriere );
+		// ... puis chaque thread y recopie son tampon.
+		if( tampon->taille > 0 ){
+			memcpy( 
+				parcours->frontiere + parcours->decalages[ thread->numero ],
+				tampon->elements, tampon->taille * sizeof(int)
+			);
+		}
+		for( i=0; i<tampon->taille; i++ ){
+			int sommet = tampon->elements[i];
+			atomic_fetch_or_explicit( 
+				&parcours->dans_frontiere[ sommet / BITS_PAR_MOT ],
+				(uint64_t) 1 << ( sommet % BITS_PAR_MOT ), memory_order_relaxed
+			);
+		}
+		pthread_barrier_wait( &parcours->barriere );
+	}
+	return NULL;
+}
+
+/*
+ * Parcourt le graphe 'avant' à partir des sommets 'sources', et renvoie 
+ * l'ensemble des états visités.
+ */
+Ensemble * parcours_en_largeur_parallele( 
+	const Numerotation * numerotation, const Graphe_compact * avant, 
+	const Graphe_compact * arriere, const Ensemble * sources, int nb_threads 
+){
+	int n = avant->n;
+	int i;
+	Parcours_parallele parcours;
+	parcours.avant = avant;
+	parcours.arriere = arriere;
+	parcours.nb_threads = nb_threads;
+	parcours.nb_mots = ( n + BITS_PAR_MOT - 1 ) / BITS_PAR_MOT;
+	parcours.visites = xmalloc( ( parcours.nb_mots + 1 ) * sizeof(_Atomic uint64_t) );
+	parcours.dans_frontiere = xmalloc( ( parcours.nb_mots + 1 ) * sizeof(_Atomic uint64_t) );
+	for( i=0; i<parcours.nb_mots; i++ ){
+		atomic_init( &parcours.visites[i], 0 );
+		atomic_init( &parcours.dans_frontiere[i], 0 );
+	}
+	parcours.frontiere = xmalloc( ( n + 1 ) * sizeof(int) );
+	parcours.taille_frontiere = 0;
+	parcours.degres_non_visites = avant->debuts[n];
+	parcours.bottom_up = 0;
+	parcours.fini = 0;
+
+	Ensemble_curseur it;
+	for(
+		it = premier_curseur_ensemble( sources );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
+	){
+		int sommet = indice_etat( numerotation, get_element_curseur( it ) );
+		if( visiter( &parcours, sommet ) ){
+			parcours.frontiere[ parcours.taille_frontiere++ ] = sommet;
+			atomic_fetch_or( 
+				&parcours.dans_frontiere[ sommet / BITS_PAR_MOT ],
+				(uint64_t) 1 << ( sommet % BITS_PAR_MOT )
+			);
+			parcours.degres_non_visites -= 
+				avant->debuts[sommet+1] - avant->debuts[sommet];
+		}
+	}
+
+	parcours.tampons = xmalloc( nb_threads * sizeof(Tampon_parcours) );
+	memset( parcours.tampons, 0, nb_threads * sizeof(Tampon_parcours) );
+	parcours.decalages = xmalloc( nb_threads * sizeof(int) );
+	pthread_barrier_init( &parcours.barriere, NULL, nb_threads );
+	Thread_parcours * threads = xmalloc( nb_threads * sizeof(Thread_parcours) );
+	pthread_t * identifiants = xmalloc( nb_threads * sizeof(pthread_t) );
+	for( i=0; i<nb_threads; i++ ){
+		threads[i].parcours = &parcours;
+		threads[i].numero = i;
+		if( pthread_create( &identifiants[i], NULL, parcourir, &threads[i] ) ){
+			ERREUR( "Impossible de créer un thread" );
+		}
+	}
+	for( i=0; i<nb_threads; i++ ){
+		pthread_join( identifiants[i], NULL );
+	}
+
+	// Les sommets sont numérotés dans l'ordre croissant des états
+	intptr_t * elements = xmalloc( ( n + 1 ) * sizeof(intptr_t) );
+	int nb_elements = 0;
+	for( i=0; i<n; i++ ){
+		if( est_visite( &parcours, i ) ){
+			elements[ nb_elements++ ] = numerotation->etats[i];
+		}
+	}
+	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
+	ajouter_elements_tries( res, elements, nb_elements );
+
+	xfree( elements );
+	xfree( identifiants );
+	xfree( threads );
+	pthread_barrier_destroy( &parcours.barriere );
+	xfree( parcours.decalages );
+	for( i=0; i<nb_threads; i++ ){
+		if( parcours.tampons[i].elements ){
+			xfree( parcours.tampons[i].elements );
+		}
+	}
+	xfree( parcours.tampons );
+	xfree( parcours.frontiere );
+	xfree( parcours.dans_frontiere );
+	xfree( parcours.visites );
+	return res;
+}
+
+Ensemble * parcours_parallele( 
+	const Automate * automate, int nb_threads, int co_accessibles 
+){
+	if( nb_threads <= 0 ){
+		nb_threads = sysconf( _SC_NPROCESSORS_ONLN );
+		if( nb_threads <= 0 ){
+			nb_threads = 1;
+		}
+	}
+	const Ensemble * etats = get_etats( automate );
+	int n = taille_ensemble( etats );
+	int * tableau_etats = xmalloc( ( n + 1 ) * sizeof(int) );
+	int i = 0;
+	Ensemble_curseur it;
+	for(
+		it = premier_curseur_ensemble( etats );
+		! curseur_ensemble_est_vide( it );
+		it = curseur_suivant_ensemble( it )
+	){
+		tableau_etats[i++] = get_element_curseur( it );
+	}
+	Numerotation numerotation;
+	numerotation.etats = tableau_etats;
+	numerotation.nb_etats = n;
+	numerotation.consecutifs = 
+		n > 0 && (long long) tableau_etats[n-1] - tableau_etats[0] == n - 1;
+
+	Graphe_compact successeurs, predecesseurs;
+	construire_successeurs( automate, &numerotation, &successeurs, nb_threads );
+	construire_predecesseurs( &successeurs, &predecesseurs );
+
+	Ensemble * res;
+	if( co_accessibles ){
+		res = parcours_en_largeur_parallele( 
+			&numerotation, &predecesseurs, &successeurs, 
+			get_finaux( automate ), nb_threads 
+		);
+	}else{
+		res = parcours_en_largeur_parallele( 
+			&numerotation, &successeurs, &predecesseurs, 
+			get_initiaux( automate ), nb_threads 
+		);
+	}
+
+	liberer_graphe_compact( &successeurs );
+	liberer_graphe_compact( &predecesseurs );
+	xfree( tableau_etats );
+	return res;
+}
+
+Ensemble * accessibles_parallele( const Automate * automate, int nb_threads ){
+	return parcours_parallele( automate, nb_threads, 0 );
+}
+
+Ensemble * co_accessibles_parallele( const Automate * automate, int nb_threads ){
+	return parcours_parallele( automate, nb_threads, 1 );
+}
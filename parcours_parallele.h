@@ -0,0 +1,72 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef __PARCOURS_PARALLELE_H__
+#define __PARCOURS_PARALLELE_H__
+
+#include "automate.h"
+
+/**
+ * @brief Renvoie l'ensemble des états accessibles à partir des états 
+ *        initiaux, calculé par un parcours en largeur parallèle.
+ *
+ * Le résultat est le même que celui de accessibles(). Les états sont d'abord
+ * numérotés de 0 à n-1 dans l'ordre croissant, et le graphe des transitions
+ * (sans les lettres) est rangé dans des tableaux d'adjacence contigus : les 
+ * successeurs sont lus en un seul passage sur les transitions, triées par 
+ * origine, leurs numéros sont calculés en parallèle, et les prédécesseurs 
+ * s'en déduisent par un tri par dénombrement. Le 
+ * parcours avance ensuite niveau par niveau : les états visités et la 
+ * frontière sont des tableaux de bits, et chaque thread accumule les états
+ * qu'il découvre dans son propre tampon. Quand la frontière est petite, 
+ * chaque thread explore les successeurs d'une partie de la frontière ; 
+ * quand elle est grande, chaque thread cherche, pour une partie des états 
+ * non visités, un prédécesseur dans la frontière (parcours « bottom-up »).
+ *
+ * L'automate est seulement lu, et ne doit pas être modifié pendant l'appel.
+ *
+ * La mémoire de l'ensemble renvoyé est laissée à la charge de l'utilisateur.
+ *
+ * @param automate Un automate.
+ * @param nb_threads Le nombre de threads à utiliser. S'il est négatif ou 
+ *        nul, le nombre de processeurs disponibles est utilisé.
+ * @return L'ensemble des états accessibles.
+ */
+Ensemble * accessibles_parallele( const Automate * automate, int nb_threads );
+
+/**
+ * @brief Renvoie l'ensemble des états co-accessibles, c'est-à-dire des états
+ *        à partir desquels un état final est accessible.
+ *
+ * Le calcul est celui de accessibles_parallele(), en remontant les 
+ * transitions à partir des états finaux.
+ *
+ * La mémoire de l'ensemble renvoyé est laissée à la charge de l'utilisateur.
+ *
+ * @param automate Un automate.
+ * @param nb_threads Le nombre de threads à utiliser. S'il est négatif ou 
+ *        nul, le nombre de processeurs disponibles est utilisé.
+ * @return L'ensemble des états co-accessibles.
+ */
+Ensemble * co_accessibles_parallele( const Automate * automate, int nb_threads );
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/** @file specialisation.h */ 
+
+#ifndef __SPECIALISATION_H__
+#define __SPECIALISATION_H__
+
+#include <assert.h>
+#include <stdint.h>
+
+#include "avl.h"
+#include "table.h"
+#include "ensemble.h"
+#include "outils.h"
+
+/**
+ * @brief Cherche une clé dans une table dont les clés sont des entiers 
+ * (table créée sans fonction de comparaison).
+ *
+ * La descente dans l'arbre compare les clés directement, sans passer par la
+ * fonction de comparaison de l'arbre : une fois la fonction mise en ligne,
+ * le compilateur voit toute la boucle.
+ *
+ * Renvoie le noeud de la clé, ou NULL si la clé n'est pas dans la table.
+ */
+static inline const struct avl_node * chercher_cle_entiere(
+	const Table * table, intptr_t cle
+){
+	assert( table->comparer_cle == NULL );
+	const struct avl_node * p = table->root->avl_root;
+	while( p ){
+		intptr_t cle_noeud = (intptr_t) p->avl_data;
+		if( cle < cle_noeud ){
+			p = p->avl_link[0];
+		}else if( cle > cle_noeud ){
+			p = p->avl_link[1];
+		}else{
+			return p;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Ajoute une clé à une table dont les clés sont des entiers (table 
+ * créée sans fonction de comparaison ni de copie des clés).
+ *
+ * Comme chercher_cle_entiere(), la descente compare les clés directement ;
+ * seul le rééquilibrage est délégué à avl_attach_node().
+ *
+ * Renvoie le noeud de la clé, et met '*ajoutee' à 1 si la clé vient d'être
+ * ajoutée (la valeur du noeud est alors nulle), à 0 si elle était déjà 
+ * dans la table.
+ */
+static inline struct avl_node * inserer_cle_entiere(
+	Table * table, intptr_t cle, int * ajoutee
+){
+	assert( table->comparer_cle == NULL && table->copier_cle == NULL );
+	detacher_table( table );
+	struct avl_node * q = NULL;
+	struct avl_node * p = table->root->avl_root;
+	int dir = 0;
+	while( p ){
+		intptr_t cle_noeud = (intptr_t) p->avl_data;
+		if( cle == cle_noeud ){
+			*ajoutee = 0;
+			return p;
+		}
+		dir = cle > cle_noeud;
+		q = p;
+		p = p->avl_link[dir];
+	}
+	p = avl_attach_node( table->root, q, dir, (void*) cle );
+	if( p == NULL ){
+		ERREUR( "Espace insuffisant" );
+	}
+	*ajoutee = 1;
+	return p;
+}
+
+/**
+ * @brief Conversion à utiliser avec DECLARER_TABLE() quand la clé est déjà
+ * un entier.
+ */
+#define SANS_CONVERSION( x ) ( x )
+
+/**
+ * @brief Déclare des fonctions typées, mises en ligne, sur un ensemble 
+ * d'entiers de type 'type' (int, char, ...) : 
+ *
+ * - int nom_contient( const Ensemble*, type element ),
+ * - void nom_ajouter( Ensemble*, type element ),
+ * - void nom_retirer( Ensemble*, type element ),
+ * - type nom_element( Ensemble_curseur curseur ).
+ *
+ * Par exemple, DECLARER_ENSEMBLE( int, etats ) déclare etats_contient(), 
+ * etats_ajouter(), ...
+ *
+ * L'ensemble doit avoir été créé sans fonction de comparaison ni de copie.
+ */
+#define DECLARER_ENSEMBLE( type, nom ) \
+	static inline int nom##_contient( const Ensemble * ensemble, type element ){ \
+		return chercher_cle_entiere( ensemble->table, (intptr_t) element ) != NULL; \
+	} \
+	static inline void nom##_ajouter( Ensemble * ensemble, type element ){ \
+		int ajoutee; \
+		inserer_cle_entiere( ensemble->table, (intptr_t) element, &ajoutee ); \
+		if( ajoutee ){ \
+			ensemble->hash ^= hash_element( (intptr_t) element ); \
+		} \
+	} \
+	static inline void nom##_retirer( Ensemble * ensemble, type element ){ \
+		retirer_element( ensemble, (intptr_t) element ); \
+	} \
+	static inline type nom##_element( Ensemble_curseur curseur ){ \
+		return (type) (intptr_t) curseur->avl_data; \
+	}
+
+/**
+ * @brief Déclare des fonctions typées, mises en ligne, sur une table qui 
+ * associe une valeur de type 'type_valeur' (un entier ou un pointeur) à une
+ * clé de type 'type_cle' :
+ *
+ * - int nom_contient( const Table*, type_cle cle ),
+ * - type_valeur nom_trouver( const Table*, type_cle cle, type_valeur defaut ),
+ *   qui renvoie 'defaut' si la clé n'est pas dans la table,
+ * - void nom_ajouter( Table*, type_cle cle, type_valeur valeur ),
+ * - type_cle nom_cle( Table_curseur curseur ),
+ * - type_valeur nom_valeur( Table_curseur curseur ).
+ *
+ * La table range ses clés dans des entiers : 'vers_entier' convertit une clé
+ * en intptr_t, en respectant l'ordre des clés, et 'depuis_entier' fait la 
+ * conversion inverse. Pour des clés entières, on utilise SANS_CONVERSION.
+ *
+ * Pour une table créée par creer_table_valeurs_en_ligne(), 'type_valeur' 
+ * est un pointeur vers la structure rangée dans les noeuds, avec les 
+ * conventions de add_table().
+ *
+ * La table doit avoir été créée sans fonction de comparaison ni de copie.
+ */
+#define DECLARER_TABLE( type_cle, type_valeur, nom, vers_entier, depuis_entier ) \
+	static inline int nom##_contient( const Table * table, type_cle cle ){ \
+		return chercher_cle_entiere( table, vers_entier( cle ) ) != NULL; \
+	} \
+	static inline type_valeur nom##_trouver( \
+		const Table * table, type_cle cle, type_valeur defaut \
+	){ \
+		const struct avl_node * n = chercher_cle_entiere( \
+			table, vers_entier( cle ) \
+		); \
+		return n ? (type_valeur) (intptr_t) n->avl_value : defaut; \
+	} \
+	static inline void nom##_ajouter( \
+		Table * table, type_cle cle, type_valeur valeur \
+	){ \
+		int ajoutee; \
+		struct avl_node * n = inserer_cle_entiere( \
+			table, vers_entier( cle ), &ajoutee \
+		); \
+		if( table->root->avl_value_size == 0 ){ \
+			n->avl_value = (void*) (intptr_t) valeur; \
+		}else{ \
+			ecrire_valeur_noeud( table, n, (intptr_t) valeur ); \
+		} \
+	} \
+	static inline type_cle nom##_cle( Table_curseur curseur ){ \
+		return depuis_entier( (intptr_t) curseur->avl_data ); \
+	} \
+	static inline type_valeur nom##_valeur( Table_curseur curseur ){ \
+		return (type_valeur) (intptr_t) curseur->avl_value; \
+	}
+
+#endif
@@ -26,92 +26,93 @@
 #include <assert.h>
 
 #include <search.h>
+#include <stdatomic.h>
 #include <stdlib.h>
-
-typedef struct Table_association {
-	void (*supprimer_cle)(intptr_t cle);
-	intptr_t (*copier_cle)(const intptr_t cle);
-	int (*comparer_cle)(const intptr_t cle1, const intptr_t cle2);
-	intptr_t cle;
-	intptr_t valeur;
-} Table_association ;
-
-struct Table {
-	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2 );
-	intptr_t (*copier_cle)( const intptr_t cle );
-	void (*supprimer_cle)(intptr_t cle);
-	struct avl_table * root;
-};
+#include <string.h>
 
 
 intptr_t get_cle( Table_iterateur it ){
-	const Table_association * asso = ( const Table_association * ) avl_t_cur( &it );
-	return (const intptr_t) asso->cle;
+	return (intptr_t) avl_t_cur( &it );
 }
 
 intptr_t get_valeur( Table_iterateur it ){
-	Table_association * asso = ( Table_association * ) avl_t_cur( &it );
-	return asso->valeur;
+	return (intptr_t) it.avl_node->avl_value;
 }
 
-Table_association * creer_table_association(
-	const Table* table, const intptr_t cle, intptr_t valeur
-){
-	Table_association * res = xmalloc(
-		sizeof( Table_association )
-	);
-	if( table->copier_cle && cle ){
-		res->cle = table->copier_cle( cle );
-	}else{
-		res->cle = cle;
-	}
-	res->valeur = valeur;
-	res->supprimer_cle = table->supprimer_cle;
-	res->copier_cle = table->copier_cle;
-	res->comparer_cle = table->comparer_cle;
-	return res;
+intptr_t get_cle_curseur( Table_curseur curseur ){
+	return (intptr_t) curseur->avl_data;
 }
 
-Table_association * copier_table_association( Table_association * asso ){
-	Table_association * res = xmalloc(
-		sizeof( Table_association )
-	);
-	*res = *asso;
-	if( asso->copier_cle && asso->cle ){
-		res->cle = asso->copier_cle( asso->cle );
+intptr_t get_valeur_curseur( Table_curseur curseur ){
+	return (intptr_t) curseur->avl_value;
+}
+
+int comparer_cles_entieres( const void * a, const void * b, void* param ){
+	intptr_t cle1 = (intptr_t) a;
+	intptr_t cle2 = (intptr_t) b;
+	if( cle1 < cle2 )
+		return -1;
+	if( cle1 > cle2 )
+		return 1;
+	return 0;
+}
+
+int comparer_cles_partage( const void * a, const void * b, void* param ){
+	const Partage_arbre * partage = (const Partage_arbre *) param;
+	return partage->comparer_cle( (intptr_t) a, (intptr_t) b );
+}
+
+intptr_t copier_cle_table( const Table* table, const intptr_t cle ){
+	if( table->copier_cle && cle ){
+		return table->copier_cle( cle );
 	}
-	return res;
+	return cle;
 }
 
-int compare_table_association( const void * pa1, const void * pb1, void* param ){
-	Table_association * pa = (Table_association *) pa1;
-	Table_association * pb = (Table_association *) pb1;
-	if( pa->comparer_cle ){
-		int r = pa->comparer_cle( pa->cle, pb->cle );
-		return r;
-	}else{
-		if( pa->cle < pb->cle )
-			return -1;
-		if( pa->cle > pb->cle )
-			return 1;
-		return 0;
+void supprimer_cle_table( const Table* table, intptr_t cle ){
+	if( table->supprimer_cle && cle ){
+		table->supprimer_cle( cle );
 	}
 }
 
+Partage_arbre * creer_partage_arbre( const Table* table ){
+	Partage_arbre * res = xmalloc( sizeof(Partage_arbre) );
+	atomic_init( &res->nb_references, 1 );
+	res->comparer_cle = table->comparer_cle;
+	return res;
+}
 
-void supprimer_table_association2( void* asso_tmp, void* data ){
-	Table_association * asso = (Table_association*) asso_tmp;
-	if( asso->supprimer_cle && asso->cle ){
-		asso->supprimer_cle( asso->cle );
+/*
+ * Donne à la table un nouvel arbre vide, qu'elle est seule à utiliser.
+ * Les clés entières sont comparées directement, sans passer par un pointeur
+ * de fonction.
+ */
+void creer_arbre( Table* table ){
+	table->partage = creer_partage_arbre( table );
+	table->root = avl_create(
+		table->comparer_cle ? comparer_cles_partage : comparer_cles_entieres,
+		table->partage, NULL
+	);
+	if( table->root == NULL ){
+		ERREUR( "Espace insuffisant" );
 	}
-	xfree(asso);
 }
 
-void supprimer_table_association( Table_association * asso ){
-	if( asso->supprimer_cle && asso->cle ){
-		asso->supprimer_cle( asso->cle );
+/*
+ * Abandonne la référence de la table sur son arbre. L'arbre est détruit si
+ * aucune autre table ne le partage.
+ */
+void relacher_arbre( Table* table ){
+	if( atomic_fetch_sub( &table->partage->nb_references, 1 ) == 1 ){
+		if( table->supprimer_cle ){
+			Table_curseur c;
+			for( c = avl_node_first( table->root ); c; c = avl_node_next( c ) ){
+				supprimer_cle_table( table, (intptr_t) c->avl_data );
+			}
+		}
+		avl_destroy ( table->root, NULL );
+		xfree( table->partage );
 	}
-	xfree(asso);
 }
 
 Table* creer_table(
@@ -120,50 +121,152 @@ Table* creer_table(
 	void (*supprimer_cle)(intptr_t cle)
 ){
 	Table* res = xmalloc( sizeof(Table) );
-	res->root = avl_create ( compare_table_association, NULL, NULL );
-
 	res->supprimer_cle = supprimer_cle;
 	res->comparer_cle = comparer_cle;
 	res->copier_cle = copier_cle;
+	creer_arbre( res );
+	return res;
+}
+
+Table* creer_table_valeurs_en_ligne(
+	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2 ),
+	intptr_t (*copier_cle)( const intptr_t cle ),
+	void (*supprimer_cle)(intptr_t cle),
+	size_t taille_valeur
+){
+	Table* res = creer_table( comparer_cle, copier_cle, supprimer_cle );
+	avl_set_value_size( res->root, taille_valeur );
+	return res;
+}
+
+void ecrire_valeur_noeud( 
+	const Table* table, struct avl_node * n, intptr_t valeur 
+){
+	size_t taille = table->root->avl_value_size;
+	if( taille == 0 ){
+		n->avl_value = (void*) valeur;
+	}else if( valeur ){
+		memcpy( n->avl_value, (const void*) valeur, taille );
+	}else{
+		memset( n->avl_value, 0, taille );
+	}
+}
+
+Table* copier_table( const Table* table ){
+	Table* res = xmalloc( sizeof(Table) );
+	*res = *table;
+	atomic_fetch_add( &res->partage->nb_references, 1 );
 	return res;
 }
 
+/*
+ * Copie l'arbre d'une table noeud par noeud, en temps linéaire : la forme de
+ * l'arbre et les facteurs d'équilibre sont conservés, sans aucune 
+ * comparaison. Les clés sont ensuite copiées sur place.
+ */
+struct avl_table * cloner_arbre( const Table * table, Partage_arbre * partage ){
+	struct avl_table * res = avl_copy( table->root, NULL, NULL, NULL );
+	if( res == NULL ){
+		ERREUR( "Espace insuffisant" );
+	}
+	res->avl_param = partage;
+	if( table->copier_cle ){
+		struct avl_node * n;
+		for(
+			n = (struct avl_node *) avl_node_first( res ); n; 
+			n = (struct avl_node *) avl_node_next( n )
+		){
+			n->avl_data = (void*) copier_cle_table( table, (intptr_t) n->avl_data );
+		}
+	}
+	return res;
+}
+
+Table* cloner_table(
+	const Table* table, intptr_t (*copier_valeur)( const intptr_t valeur )
+){
+	Table* res = xmalloc( sizeof(Table) );
+	*res = *table;
+	res->partage = creer_partage_arbre( table );
+	res->root = cloner_arbre( table, res->partage );
+	assert( copier_valeur == NULL || table->root->avl_value_size == 0 );
+	if( copier_valeur ){
+		struct avl_node * n;
+		for(
+			n = (struct avl_node *) avl_node_first( res->root ); n; 
+			n = (struct avl_node *) avl_node_next( n )
+		){
+			n->avl_value = (void*) copier_valeur( (intptr_t) n->avl_value );
+		}
+	}
+	return res;
+}
+
+void detacher_table( Table* table ){
+	if( atomic_load( &table->partage->nb_references ) == 1 ) return;
+
+	// L'arbre est copié avant d'abandonner la référence : une autre table
+	// pourrait sinon le modifier ou le détruire pendant la copie.
+	Partage_arbre * partage = creer_partage_arbre( table );
+	struct avl_table * root = cloner_arbre( table, partage );
+	relacher_arbre( table );
+	table->root = root;
+	table->partage = partage;
+}
+
 void liberer_table( Table* table ){
 	assert( table );
-	avl_destroy ( table->root, supprimer_table_association2 );
+	relacher_arbre( table );
 	xfree( table );
 }
 
 void add_table( Table* table, const intptr_t cle, intptr_t valeur ) {
-	Table_association* asso = creer_table_association(table, cle, valeur);
-	void* val = avl_probe ( table->root, (void*) asso );
-	if( val == NULL ){
+	detacher_table( table );
+	size_t taille = avl_count( table->root );
+	struct avl_node * n = avl_probe_node( table->root, (void*) cle );
+	if( n == NULL ){
 		ERREUR( "Espace insuffisant" );
 	}
-	Table_association* asso_tree = *( Table_association** ) val; 
-	if( asso_tree != asso  ){
-		supprimer_table_association( asso );
-		asso_tree->valeur = valeur;
+	// La clé n'est copiée que si elle vient d'être ajoutée
+	if( avl_count( table->root ) != taille ){
+		n->avl_data = (void*) copier_cle_table( table, cle );
 	}
+	ecrire_valeur_noeud( table, n, valeur );
 }
 
-intptr_t delete_table( Table* table, intptr_t cle ){
-	intptr_t valeur = (intptr_t) NULL;
-	Table_association* asso_tree = NULL;
-	Table_association* asso = creer_table_association(
-		table, cle, (intptr_t) NULL
-	);
-	void* val = avl_find( table->root, (void*) asso );
-	if( val ){
-		asso_tree = ( Table_association* ) val; 
-		valeur = asso_tree->valeur;
+void add_table_triee(
+	Table* table, const intptr_t* cles, const intptr_t* valeurs, int n
+){
+	int i;
+	detacher_table( table );
+	if( avl_count( table->root ) != 0 ){
+		for( i=0; i<n; i++ ){
+			add_table( table, cles[i], valeurs ? valeurs[i] : (intptr_t) NULL );
+		}
+		return;
+	}
+	void ** donnees = xmalloc( ( n + 1 ) * sizeof(void*) );
+	void ** valeurs_avl = xmalloc( ( n + 1 ) * sizeof(void*) );
+	for( i=0; i<n; i++ ){
+		donnees[i] = (void*) copier_cle_table( table, cles[i] );
+		valeurs_avl[i] = valeurs ? (void*) valeurs[i] : NULL;
+	}
+	if( ! avl_build_sorted( table->root, donnees, valeurs_avl, n ) ){
+		ERREUR( "Espace insuffisant" );
 	}
-	avl_delete( table->root, (void*) asso );
-	if(asso_tree){
-		supprimer_table_association( asso_tree );
+	xfree( valeurs_avl );
+	xfree( donnees );
+}
+
+intptr_t delete_table( Table* table, intptr_t cle ){
+	detacher_table( table );
+	void * cle_arbre;
+	void * valeur;
+	if( avl_remove( table->root, (void*) cle, &cle_arbre, &valeur ) ){
+		supprimer_cle_table( table, (intptr_t) cle_arbre );
+		return (intptr_t) valeur;
 	}
-	supprimer_table_association( asso );
-	return valeur;
+	return (intptr_t) NULL;
 }
 
 void pour_toute_cle_valeur_table(
@@ -171,12 +274,9 @@ void pour_toute_cle_valeur_table(
 	void (* action)( const intptr_t cle, intptr_t valeur, void* data  ),
 	void* data
 ){
-	struct avl_traverser traverser;
-	void * item;
-	avl_t_init( &traverser, table->root );
-	while( (item = avl_t_next( &traverser )) ){
-		Table_association* asso = (Table_association *) item;
-		action( asso->cle, asso->valeur, data );
+	Table_curseur c;
+	for( c = avl_node_first( table->root ); c; c = avl_node_next( c ) ){
+		action( (intptr_t) c->avl_data, (intptr_t) c->avl_value, data );
 	}
 }
 
@@ -199,8 +299,9 @@ void pour_toute_valeur_table(
 }
 
 void vider_table( Table* table ){
-	avl_destroy ( table->root, supprimer_table_association2 );
-	table->root = avl_create ( compare_table_association, NULL, NULL );
+	// Inutile de copier un arbre partagé que l'on va vider
+	relacher_arbre( table );
+	creer_arbre( table );
 }
 
 typedef struct {
@@ -240,11 +341,7 @@ void print_table(
 
 Table_iterateur trouver_table( const Table* table, intptr_t cle ){
 	Table_iterateur it;
-	Table_association* asso = creer_table_association(
-		table, cle, (intptr_t) NULL
-	);
-	avl_t_find( &it, table->root, (void*) asso );
-	supprimer_table_association( asso );
+	avl_t_find( &it, table->root, (void*) cle );
 	return it;
 }
 
@@ -254,9 +351,7 @@ Table_iterateur premier_iterateur_table( const Table* table ){
 	return it;
 }
 
-Table_iterateur dernier_iterateur_table(
-	const Table_iterateur * iterator, Table* table 
-){
+Table_iterateur dernier_iterateur_table( const Table* table ){
 	Table_iterateur it;
 	avl_t_last( &it, table->root );
 	return it;
@@ -276,15 +371,41 @@ Table_iterateur iterateur_precedent_table( Table_iterateur iterateur ){
 	return iterateur;
 }
 
+Table_curseur premier_curseur_table( const Table* table ){
+	return avl_node_first( table->root );
+}
+
+Table_curseur dernier_curseur_table( const Table* table ){
+	return avl_node_last( table->root );
+}
+
+Table_curseur curseur_suivant_table( Table_curseur curseur ){
+	return avl_node_next( curseur );
+}
+
+Table_curseur curseur_precedent_table( Table_curseur curseur ){
+	return avl_node_prev( curseur );
+}
+
+int curseur_est_vide( Table_curseur curseur ){
+	return curseur == NULL;
+}
+
 int taille_table( Table* t ){
-	int res = 0;
-	Table_iterateur it1;
-	for(
-		it1 = premier_iterateur_table( t );
-		! iterateur_est_vide( it1 );
-		it1 = iterateur_suivant_table( it1 )
-	){
-		res += 1;
-	}
-	return res;
-};
+	return avl_count( t->root );
+}
+
+void table_memoire( const Table* table, Table_memoire_stats* stats ){
+	memset( stats, 0, sizeof(Table_memoire_stats) );
+	compter_memoire( &stats->table, 1, sizeof(Table) );
+	compter_memoire( &stats->arbre, 1, sizeof(struct avl_table) );
+	compter_memoire( &stats->arbre, 1, sizeof(Partage_arbre) );
+	compter_memoire( 
+		&stats->noeuds, avl_count( table->root ), 
+		sizeof(struct avl_node) + table->root->avl_value_size
+	);
+	ajouter_memoire( &stats->total, stats->table );
+	ajouter_memoire( &stats->total, stats->arbre );
+	ajouter_memoire( &stats->total, stats->noeuds );
+	stats->nb_partages = atomic_load( &table->partage->nb_references );
+}
@@ -23,9 +23,38 @@
 #ifndef __TABLE_H__
 #define __TABLE_H__
 
+#include <stdatomic.h>
 #include <stdint.h>
 #include "avl.h"
 
+/**
+ * @brief Données communes à toutes les tables qui partagent un même arbre 
+ * (voir copier_table()) : le nombre de ces tables et la fonction de 
+ * comparaison des clés, que l'arbre reçoit en paramètre.
+ */
+typedef struct Partage_arbre {
+	atomic_int nb_references;
+	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2 );
+} Partage_arbre;
+
+/**
+ * @brief Représentation d'une table.
+ *
+ * Les clés et les valeurs sont rangées directement dans les noeuds de 
+ * l'arbre ('avl_data' et 'avl_value') : une association ne coûte qu'une 
+ * allocation, et les fonctions de la table ne sont stockées qu'une fois.
+ *
+ * Les champs ne sont visibles que pour permettre les recherches spécialisées
+ * de specialisation.h ; ils ne doivent pas être modifiés directement.
+ */
+struct Table {
+	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2 );
+	intptr_t (*copier_cle)( const intptr_t cle );
+	void (*supprimer_cle)(intptr_t cle);
+	struct avl_table * root;
+	Partage_arbre * partage;
+};
+
 /**
  * @brief Définit le type d'une table.
  * 
@@ -41,6 +70,31 @@ typedef struct Table Table;
  */
 typedef struct avl_traverser Table_iterateur;
 
+/**
+ * @brief Définit le type d'un curseur sur les éléments d'une table.
+ *
+ * Un curseur parcourt la table dans le même ordre qu'un Table_iterateur,
+ * mais il n'a la taille que d'un pointeur : l'association suivante est 
+ * retrouvée en remontant les pointeurs parents de l'arbre au lieu de
+ * conserver une pile de nœuds. Il est donc copié en temps constant à chaque
+ * pas du parcours.
+ *
+ * Voici comment parcourir une table avec un curseur :
+ *
+ * Table_curseur c;
+ * for( 
+ *     c = premier_curseur_table( table ); 
+ *     ! curseur_est_vide( c );  
+ *     c = curseur_suivant_table( c )
+ * ){
+ *     printf( "%d -> %d\n", get_cle_curseur( c ), get_valeur_curseur( c ) );
+ * }
+ *
+ * Comme un itérateur, un curseur est invalidé par toute modification de la
+ * table.
+ */
+typedef const struct avl_node * Table_curseur;
+
 /**
  * @brief Renvoie une nouvelle table.
  *
@@ -150,6 +204,34 @@ Table* creer_table(
 	void (*supprimer_cle)(intptr_t cle)
 );
 
+/**
+ * @brief
+ * Renvoie une nouvelle table, comme creer_table(), dont les valeurs sont des
+ * structures de 'taille_valeur' octets rangées dans les noeuds de l'arbre : 
+ * une association ne coûte toujours qu'une allocation.
+ *
+ * Dans une telle table :
+ *  - la valeur passée à add_table() et add_table_triee() est un pointeur 
+ *    vers les octets à recopier dans le noeud, ou 0 pour une valeur remplie
+ *    de zéros ;
+ *  - la valeur renvoyée par get_valeur(), get_valeur_curseur(), ... est un 
+ *    pointeur vers la structure rangée dans le noeud, qui peut être modifiée
+ *    sur place ; comme un itérateur, il est invalidé par toute modification
+ *    de la table ;
+ *  - copier_table() et cloner_table() recopient les structures octet par 
+ *    octet (cloner_table() n'accepte pas de fonction 'copier_valeur') ;
+ *  - delete_table() renvoie 0 : la valeur est détruite avec son noeud.
+ *
+ * Comme pour creer_table(), la mémoire éventuellement pointée par les 
+ * structures reste à la charge de l'utilisateur.
+ */
+Table* creer_table_valeurs_en_ligne(
+	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2),
+	intptr_t (*copier_cle)( const intptr_t cle ),
+	void (*supprimer_cle)(intptr_t cle),
+	size_t taille_valeur
+);
+
 /**
  * @brief
  * Cette fonction détruit une table. La mémoire qui a été allouée par la table 
@@ -160,6 +242,62 @@ Table* creer_table(
  */
 void liberer_table( Table* table );
 
+/**
+ * @brief
+ * Renvoie une copie de la table passée en paramètre, en temps constant.
+ *
+ * La copie partage la mémoire de la table d'origine jusqu'à ce que l'une des 
+ * deux tables soit modifiée : la table modifiée récupère alors une copie 
+ * privée de ses associations (copie sur écriture). Les deux tables restent 
+ * donc indépendantes pour l'utilisateur, qui doit libérer chacune d'elles 
+ * avec liberer_table().
+ *
+ * Le partage porte sur l'arbre entier : la première modification d'une 
+ * table partagée clone tout l'arbre, en temps linéaire (voir 
+ * cloner_table()), et non le seul chemin modifié.
+ *
+ * Comme pour les autres fonctions de la table, seules les clés sont copiées :
+ * les valeurs de la copie sont les mêmes que celles de la table d'origine.
+ */
+Table* copier_table( const Table* table );
+
+/**
+ * @brief
+ * Renvoie une copie profonde de la table passée en paramètre, en temps 
+ * linéaire.
+ *
+ * Contrairement à copier_table(), la copie ne partage aucune mémoire avec la 
+ * table d'origine : l'arbre est cloné noeud par noeud, en conservant sa 
+ * forme, sans aucune comparaison ni rééquilibrage.
+ *
+ * Si 'copier_valeur' n'est pas NULL, la fonction est appelée sur chaque 
+ * valeur et son résultat est enregistré dans la copie. Sinon, les valeurs de
+ * la copie sont les mêmes que celles de la table d'origine.
+ */
+Table* cloner_table(
+	const Table* table, intptr_t (*copier_valeur)( const intptr_t valeur )
+);
+
+/**
+ * @brief
+ * Si l'arbre de la table est partagé avec d'autres tables (voir 
+ * copier_table()), donne à la table une copie privée de l'arbre. 
+ *
+ * Toute modification directe de l'arbre doit être précédée d'un appel à 
+ * cette fonction.
+ */
+void detacher_table( Table* table );
+
+/**
+ * @brief
+ * Donne sa valeur à un noeud de l'arbre de la table, avec la convention de 
+ * add_table() : pour une table créée par creer_table_valeurs_en_ligne(), 
+ * les octets pointés par 'valeur' sont recopiés dans le noeud.
+ */
+void ecrire_valeur_noeud( 
+	const Table* table, struct avl_node * n, intptr_t valeur 
+);
+
 /**
  * @brief
  * La fonction add_table() ajoute une association entre une clé et une valeur.
@@ -177,6 +315,23 @@ void liberer_table( Table* table );
 void add_table( Table* table, const intptr_t cle, const intptr_t valeur );
 
 
+/**
+ * @brief
+ * Ajoute à la table les 'n' associations ('cles'[i], 'valeurs'[i]).
+ *
+ * Les clés doivent être triées par ordre strictement croissant (pour la 
+ * fonction de comparaison des clés de la table). Comme pour add_table(), les 
+ * clés sont copiées et leur mémoire est gérée par la table.
+ * Si 'valeurs' vaut NULL, toutes les clés sont associées à la valeur NULL.
+ *
+ * Si la table est vide, l'arbre est construit directement en temps linéaire,
+ * sans aucune comparaison ni rééquilibrage. Sinon, les associations sont 
+ * ajoutées une à une avec add_table().
+ */
+void add_table_triee(
+	Table* table, const intptr_t* cles, const intptr_t* valeurs, int n
+);
+
 /**
  * @brief
  * Supprime une clé de la table. La mémoire de la clé est libérée et la valeur
@@ -266,6 +421,12 @@ Table_iterateur trouver_table( const Table* table, const intptr_t cle );
  */
 Table_iterateur premier_iterateur_table( const Table* table );
 
+/**
+ * @brief
+ * Renvoie un itérateur positionné sur la dernière association de la table.
+ */
+Table_iterateur dernier_iterateur_table( const Table* table );
+
 /**
  * @brief
  * Renvoie l'itérateur suivant.
@@ -319,8 +480,109 @@ intptr_t get_valeur( Table_iterateur it );
 
 /**
  * @brief
- * Renvoie la taille de la table.
+ * Renvoie un curseur positionné sur la première association de la table, ou
+ * le curseur vide si la table est vide.
+ */
+Table_curseur premier_curseur_table( const Table* table );
+
+/**
+ * @brief
+ * Renvoie un curseur positionné sur la dernière association de la table, ou
+ * le curseur vide si la table est vide.
+ */
+Table_curseur dernier_curseur_table( const Table* table );
+
+/**
+ * @brief
+ * Renvoie le curseur positionné sur l'association suivante, ou le curseur 
+ * vide si le curseur passé en paramètre est sur la plus grande association.
+ *
+ * Le coût amorti d'un pas est constant.
+ */
+Table_curseur curseur_suivant_table( Table_curseur curseur );
+
+/**
+ * @brief
+ * Renvoie le curseur positionné sur l'association précédente, ou le curseur
+ * vide si le curseur passé en paramètre est sur la plus petite association.
+ */
+Table_curseur curseur_precedent_table( Table_curseur curseur );
+
+/**
+ * @brief
+ * Renvoie 1 si le curseur passé en paramètre est vide.
+ * Renvoie 0 sinon.
+ */
+int curseur_est_vide( Table_curseur curseur );
+
+/**
+ * @brief
+ * Renvoie la clé de l'association pointée par le curseur.
+ */
+intptr_t get_cle_curseur( Table_curseur curseur );
+
+/**
+ * @brief
+ * Renvoie la valeur de l'association pointée par le curseur.
+ */
+intptr_t get_valeur_curseur( Table_curseur curseur );
+
+/**
+ * @brief
+ * Renvoie la taille de la table, en temps constant.
  */
 int taille_table( Table* t );
 
+/**
+ * @brief
+ * Mémoire occupée par une structure : nombre d'octets demandés à xmalloc()
+ * et nombre d'allocations. Le surcoût propre à l'allocateur n'est pas 
+ * compté.
+ */
+typedef struct Memoire {
+	size_t octets;
+	size_t allocations;
+} Memoire;
+
+/**
+ * @brief
+ * Ajoute 'n' allocations de 'octets' octets chacune.
+ */
+static inline void compter_memoire( Memoire * memoire, size_t n, size_t octets ){
+	memoire->octets += n * octets;
+	memoire->allocations += n;
+}
+
+/**
+ * @brief
+ * Ajoute la mémoire 'm' à 'total'.
+ */
+static inline void ajouter_memoire( Memoire * total, Memoire m ){
+	total->octets += m.octets;
+	total->allocations += m.allocations;
+}
+
+/**
+ * @brief
+ * Détail de la mémoire occupée par une table.
+ */
+typedef struct Table_memoire_stats {
+	Memoire table; //!< La structure Table.
+	Memoire arbre; //!< L'en-tête de l'arbre AVL et son bloc de partage.
+	Memoire noeuds; //!< Les noeuds de l'arbre, qui contiennent les clés et les valeurs.
+	Memoire total; //!< La somme des trois.
+	int nb_partages; //!< Nombre de tables qui partagent l'arbre.
+} Table_memoire_stats;
+
+/**
+ * @brief
+ * Calcule la mémoire occupée par la table, en temps constant.
+ *
+ * Les clés allouées par 'copier_cle' et la mémoire pointée par les valeurs
+ * ne sont pas comptées. Un arbre partagé avec d'autres tables (voir 
+ * copier_table()) est compté en entier : 'nb_partages' indique entre 
+ * combien de tables il est partagé.
+ */
+void table_memoire( const Table* table, Table_memoire_stats* stats );
+
 #endif
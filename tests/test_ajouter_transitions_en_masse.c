@@ -0,0 +1,228 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "automate.h"
+#include "outils.h"
+
+#include <stdlib.h>
+
+typedef struct {
+	Automate * automate;
+	int toutes_presentes;
+} Verification;
+
+void verifier_transition( int origine, char lettre, int fin, void* data ){
+	Verification * v = (Verification*) data;
+	if( ! est_une_transition_de_l_automate( v->automate, origine, lettre, fin ) ){
+		v->toutes_presentes = 0;
+	}
+}
+
+int memes_transitions( Automate * aut1, Automate * aut2 ){
+	Verification v1 = { aut2, 1 };
+	Verification v2 = { aut1, 1 };
+	pour_toute_transition( aut1, verifier_transition, &v1 );
+	pour_toute_transition( aut2, verifier_transition, &v2 );
+	return
+		v1.toutes_presentes && v2.toutes_presentes
+		&& comparer_ensemble( get_etats( aut1 ), get_etats( aut2 ) ) == 0
+		&& comparer_ensemble( get_alphabet( aut1 ), get_alphabet( aut2 ) ) == 0;
+}
+
+int test_ajouter_transitions_en_masse(){
+	int result = 1;
+
+	{
+		int origines[] = { 0, 1, 0, 2, 0, 1 };
+		char lettres[] = { 'a', 'b', 'a', 'a', 'a', 'b' };
+		int fins[] = { 1, 2, 2, 2, 1, 2 };
+
+		Automate * automate = creer_automate();
+		ajouter_transitions_en_masse( automate, origines, lettres, fins, 6 );
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 2 );
+
+		TEST(
+			1
+			&& taille_ensemble( get_etats( automate ) ) == 3
+			&& taille_ensemble( get_alphabet( automate ) ) == 2
+			&& taille_destinations( voisins( automate, 0, 'a' ) ) == 2
+			&& le_mot_est_reconnu( automate, "a" )
+			&& le_mot_est_reconnu( automate, "ab" )
+			&& le_mot_est_reconnu( automate, "aaaa" )
+			&& ! le_mot_est_reconnu( automate, "b" )
+			, result
+		);
+		liberer_automate( automate );
+	}
+
+	{
+		int n = 20000;
+		int i;
+		int * origines = xmalloc( n * sizeof(int) );
+		char * lettres = xmalloc( n * sizeof(char) );
+		int * fins = xmalloc( n * sizeof(int) );
+		srand( 42 );
+		for( i=0; i<n; i++ ){
+			origines[i] = rand() % 1000 - 500;
+			lettres[i] = 'a' + rand() % 26;
+			fins[i] = rand() % 1000 - 500;
+		}
+
+		Automate * temoin = creer_automate();
+		for( i=0; i<n; i++ ){
+			ajouter_transition( temoin, origines[i], lettres[i], fins[i] );
+		}
+
+		// Construction depuis un automate vide
+		Automate * automate = creer_automate();
+		ajouter_transitions_en_masse( automate, origines, lettres, fins, n );
+		TEST( memes_transitions( automate, temoin ), result );
+		liberer_automate( automate );
+
+		// Construction en deux fois : la seconde moitié complète un automate
+		// non vide
+		automate = creer_automate();
+		ajouter_transitions_en_masse( automate, origines, lettres, fins, n/2 );
+		ajouter_transitions_en_masse(
+			automate, origines + n/2, lettres + n/2, fins + n/2, n - n/2
+		);
+		TEST( memes_transitions( automate, temoin ), result );
+		liberer_automate( automate );
+
+		liberer_automate( temoin );
+		xfree( origines );
+		xfree( lettres );
+		xfree( fins );
+	}
+
+	return result;
+}
+
+typedef struct {
+	int * origines;
+	char * lettres;
+	int * fins;
+	int n;
+} Transitions_lues;
+
+void lire_transition( int origine, char lettre, int fin, void* data ){
+	Transitions_lues * t = (Transitions_lues*) data;
+	t->origines[t->n] = origine;
+	t->lettres[t->n] = lettre;
+	t->fins[t->n] = fin;
+	t->n++;
+}
+
+int test_ajouter_transitions_triees(){
+	int result = 1;
+	int ajoutees;
+
+	{
+		// Les lettres sont comparées comme des char
+		int origines[] = { -1, 0, 0, 0, 0, 3 };
+		char lettres[] = { 'a', (char) 200, 'a', 'a', 'b', 'a' };
+		int fins[] = { 0, 1, 1, 2, 3, 3 };
+
+		Automate * automate = creer_automate();
+		ajoutees = ajouter_transitions_triees( automate, origines, lettres, fins, 6 );
+		TEST( ajoutees, result );
+		TEST( taille_ensemble( get_etats( automate ) ) == 5, result );
+		TEST( taille_ensemble( get_alphabet( automate ) ) == 3, result );
+		TEST( taille_destinations( voisins( automate, 0, 'a' ) ) == 2, result );
+		TEST( est_une_transition_de_l_automate( automate, 0, (char) 200, 1 ), result );
+		TEST( ! est_deterministe( automate ), result );
+
+		// Un doublon, une origine, une lettre ou une fin décroissante sont 
+		// refusés
+		Automate * refus = creer_automate();
+		int fins_doublon[] = { 0, 1, 2, 2, 3, 3 };
+		ajoutees = ajouter_transitions_triees( 
+			refus, origines, lettres, fins_doublon, 6 
+		);
+		TEST( ! ajoutees, result );
+		int fins_decroissantes[] = { 0, 1, 2, 1, 3, 3 };
+		ajoutees = ajouter_transitions_triees( 
+			refus, origines, lettres, fins_decroissantes, 6 
+		);
+		TEST( ! ajoutees, result );
+		char lettres_decroissantes[] = { 'a', (char) 200, 'a', 'a', 'A', 'a' };
+		ajoutees = ajouter_transitions_triees( 
+			refus, origines, lettres_decroissantes, fins, 6 
+		);
+		TEST( ! ajoutees, result );
+		int origines_decroissantes[] = { -1, 0, 0, 0, 0, -3 };
+		ajoutees = ajouter_transitions_triees( 
+			refus, origines_decroissantes, lettres, fins, 6 
+		);
+		TEST( ! ajoutees, result );
+		TEST( taille_ensemble( get_etats( refus ) ) == 0, result );
+		TEST( taille_table( refus->transitions ) == 0, result );
+
+		liberer_automate( refus );
+		liberer_automate( automate );
+	}
+
+	{
+		// Les transitions d'un automate, dans l'ordre de 
+		// pour_toute_transition(), sont triées
+		int n = 5000;
+		int i;
+		Automate * temoin = creer_automate();
+		srand( 7 );
+		for( i=0; i<n; i++ ){
+			ajouter_transition( 
+				temoin, rand() % 300 - 150, 'a' + rand() % 26, rand() % 300 
+			);
+		}
+		Transitions_lues t;
+		t.origines = xmalloc( n * sizeof(int) );
+		t.lettres = xmalloc( n * sizeof(char) );
+		t.fins = xmalloc( n * sizeof(int) );
+		t.n = 0;
+		pour_toute_transition( temoin, lire_transition, &t );
+
+		Automate * automate = creer_automate();
+		ajoutees = ajouter_transitions_triees( 
+			automate, t.origines, t.lettres, t.fins, t.n 
+		);
+		TEST( ajoutees, result );
+		TEST( memes_transitions( automate, temoin ), result );
+
+		liberer_automate( automate );
+		liberer_automate( temoin );
+		xfree( t.origines );
+		xfree( t.lettres );
+		xfree( t.fins );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_ajouter_transitions_en_masse() ){ return 1; };
+	if( ! test_ajouter_transitions_triees() ){ return 1; };
+
+	return 0;
+	
+}
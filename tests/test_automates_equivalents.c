@@ -0,0 +1,117 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "automate.h"
+#include "outils.h"
+
+int test_automates_equivalents(){
+	int result = 1;
+
+	{
+		Automate * aut1 = mot_to_automate( "abc" );
+		Automate * aut2 = translater_automate_entier( aut1, 10 );
+		Automate * aut3 = mot_to_automate( "abd" );
+		Automate * aut4 = mot_to_automate( "ab" );
+
+		TEST(
+			1
+			&& les_automates_deterministes_sont_equivalents( aut1, aut1 )
+			&& les_automates_deterministes_sont_equivalents( aut1, aut2 )
+			&& les_automates_deterministes_sont_equivalents( aut2, aut1 )
+			&& ! les_automates_deterministes_sont_equivalents( aut1, aut3 )
+			&& ! les_automates_deterministes_sont_equivalents( aut1, aut4 )
+			&& ! les_automates_deterministes_sont_equivalents( aut4, aut1 )
+			, result
+		);
+
+		liberer_automate( aut1 );
+		liberer_automate( aut2 );
+		liberer_automate( aut3 );
+		liberer_automate( aut4 );
+	}
+
+	{
+		// (ab)* avec deux états et avec quatre états
+		Automate * aut1 = creer_automate();
+		ajouter_transition( aut1, 0, 'a', 1 );
+		ajouter_transition( aut1, 1, 'b', 0 );
+		ajouter_etat_initial( aut1, 0 );
+		ajouter_etat_final( aut1, 0 );
+
+		Automate * aut2 = creer_automate();
+		ajouter_transition( aut2, 5, 'a', 6 );
+		ajouter_transition( aut2, 6, 'b', 7 );
+		ajouter_transition( aut2, 7, 'a', 8 );
+		ajouter_transition( aut2, 8, 'b', 5 );
+		ajouter_etat_initial( aut2, 5 );
+		ajouter_etat_final( aut2, 5 );
+		ajouter_etat_final( aut2, 7 );
+
+		// Un état puits explicite ne change pas le langage
+		Automate * aut3 = creer_automate();
+		ajouter_transition( aut3, 0, 'a', 1 );
+		ajouter_transition( aut3, 1, 'b', 0 );
+		ajouter_transition( aut3, 0, 'b', 2 );
+		ajouter_transition( aut3, 1, 'a', 2 );
+		ajouter_transition( aut3, 2, 'a', 2 );
+		ajouter_transition( aut3, 2, 'b', 2 );
+		ajouter_etat_initial( aut3, 0 );
+		ajouter_etat_final( aut3, 0 );
+
+		// (ab)*a
+		Automate * aut4 = creer_automate();
+		ajouter_transition( aut4, 0, 'a', 1 );
+		ajouter_transition( aut4, 1, 'b', 0 );
+		ajouter_etat_initial( aut4, 0 );
+		ajouter_etat_final( aut4, 1 );
+
+		Automate * vide = creer_automate();
+
+		TEST(
+			1
+			&& les_automates_deterministes_sont_equivalents( aut1, aut2 )
+			&& les_automates_deterministes_sont_equivalents( aut1, aut3 )
+			&& les_automates_deterministes_sont_equivalents( aut2, aut3 )
+			&& ! les_automates_deterministes_sont_equivalents( aut1, aut4 )
+			&& ! les_automates_deterministes_sont_equivalents( aut1, vide )
+			&& les_automates_deterministes_sont_equivalents( vide, vide )
+			, result
+		);
+
+		liberer_automate( aut1 );
+		liberer_automate( aut2 );
+		liberer_automate( aut3 );
+		liberer_automate( aut4 );
+		liberer_automate( vide );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_automates_equivalents() ){ return 1; };
+
+	return 0;
+	
+}
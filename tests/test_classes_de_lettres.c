@@ -0,0 +1,114 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "automate.h"
+#include "outils.h"
+
+#include <limits.h>
+
+int test_classes_de_lettres(){
+	int result = 1;
+
+	{
+		Automate * automate = creer_automate();
+		Classes_lettres classes;
+		calculer_classes_de_lettres( automate, &classes );
+
+		TEST(
+			1
+			&& classes.nb_classes == 1
+			&& classe_de_lettre( &classes, 'a' ) == 0
+			&& classe_de_lettre( &classes, (char) 200 ) == 0
+			, result
+		);
+
+		liberer_automate( automate );
+	}
+
+	{
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 0, 'b', 1 );
+		ajouter_transition( automate, 1, 'c', 2 );
+		ajouter_transition( automate, 1, 'd', 2 );
+		ajouter_transition( automate, 1, 'e', 2 );
+		ajouter_transition( automate, 0, 'e', 2 );
+		ajouter_transition( automate, 2, 'f', 0 );
+		ajouter_transition( automate, 2, 'f', 1 );
+		ajouter_transition( automate, 2, 'g', 0 );
+		ajouter_lettre( automate, 'h' );
+
+		Classes_lettres classes;
+		calculer_classes_de_lettres( automate, &classes );
+
+		TEST(
+			1
+			&& classes.nb_classes == 6
+			&& classe_de_lettre( &classes, 'h' ) == 0
+			&& classe_de_lettre( &classes, 'z' ) == 0
+			&& classe_de_lettre( &classes, (char) 200 ) == 0
+			&& classe_de_lettre( &classes, 'a' ) == classe_de_lettre( &classes, 'b' )
+			&& classe_de_lettre( &classes, 'c' ) == classe_de_lettre( &classes, 'd' )
+			&& classe_de_lettre( &classes, 'a' ) != 0
+			&& classe_de_lettre( &classes, 'a' ) != classe_de_lettre( &classes, 'c' )
+			&& classe_de_lettre( &classes, 'c' ) != classe_de_lettre( &classes, 'e' )
+			&& classe_de_lettre( &classes, 'f' ) != classe_de_lettre( &classes, 'g' )
+			, result
+		);
+
+		liberer_automate( automate );
+	}
+
+	{
+		// Toutes les valeurs étiquettent une transition : aucune classe 
+		// n'est réservée aux lettres sans transitions.
+		Automate * automate = creer_automate();
+		int i;
+		for( i=CHAR_MIN; i<=CHAR_MAX; i++ ){
+			ajouter_transition( automate, 0, (char) i, ( i == 'a' ) ? 2 : 1 );
+		}
+
+		Classes_lettres classes;
+		calculer_classes_de_lettres( automate, &classes );
+
+		TEST(
+			1
+			&& classes.nb_classes == 2
+			&& classe_de_lettre( &classes, 'b' ) == classe_de_lettre( &classes, (char) 200 )
+			&& classe_de_lettre( &classes, 'a' ) != classe_de_lettre( &classes, 'b' )
+			, result
+		);
+
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_classes_de_lettres() ){ return 1; };
+
+	return 0;
+	
+}
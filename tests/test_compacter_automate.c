@@ -0,0 +1,101 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "automate.h"
+#include "outils.h"
+
+int test_compacter_automate(){
+	int result = 1;
+
+	{
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 100, 'a', 7 );
+		ajouter_transition( automate, 100, 'b', -3 );
+		ajouter_transition( automate, 7, 'a', 1000 );
+		ajouter_transition( automate, -3, 'b', 1000 );
+		ajouter_transition( automate, 1000, 'a', 100 );
+		ajouter_transition( automate, 55, 'a', 100 );
+		ajouter_etat_initial( automate, 100 );
+		ajouter_etat_final( automate, 1000 );
+
+		Table * numeros = compacter_automate( automate );
+
+		TEST(
+			1
+			&& taille_ensemble( get_etats( automate ) ) == 5
+			&& get_min_etat( automate ) == 0
+			&& get_max_etat( automate ) == 4
+			&& get_valeur( trouver_table( numeros, 100 ) ) == 0
+			&& get_valeur( trouver_table( numeros, 7 ) ) == 1
+			&& get_valeur( trouver_table( numeros, -3 ) ) == 2
+			&& get_valeur( trouver_table( numeros, 1000 ) ) == 3
+			&& get_valeur( trouver_table( numeros, 55 ) ) == 4
+			&& est_un_etat_initial_de_l_automate( automate, 0 )
+			&& est_un_etat_final_de_l_automate( automate, 3 )
+			&& est_une_transition_de_l_automate( automate, 0, 'a', 1 )
+			&& est_une_transition_de_l_automate( automate, 4, 'a', 0 )
+			&& le_mot_est_reconnu( automate, "aa" )
+			&& le_mot_est_reconnu( automate, "bb" )
+			&& le_mot_est_reconnu( automate, "aaabb" )
+			&& ! le_mot_est_reconnu( automate, "ab" )
+			, result
+		);
+
+		liberer_table( numeros );
+		liberer_automate( automate );
+	}
+
+	{
+		// Deux automates identiques à renumérotation près
+		Automate * automate_1 = mot_to_automate( "abcd" );
+		Automate * automate_2 = translater_automate_entier( automate_1, 42 );
+		Table * numeros_1 = compacter_automate( automate_1 );
+		Table * numeros_2 = compacter_automate( automate_2 );
+
+		TEST(
+			1
+			&& comparer_ensemble( 
+				get_etats( automate_1 ), get_etats( automate_2 ) 
+			) == 0
+			&& est_une_transition_de_l_automate( automate_2, 0, 'a', 1 )
+			&& est_une_transition_de_l_automate( automate_2, 3, 'd', 4 )
+			&& est_un_etat_final_de_l_automate( automate_2, 4 )
+			, result
+		);
+
+		liberer_table( numeros_1 );
+		liberer_table( numeros_2 );
+		liberer_automate( automate_1 );
+		liberer_automate( automate_2 );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_compacter_automate() ){ return 1; };
+
+	return 0;
+	
+}
@@ -0,0 +1,194 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "automate.h"
+#include "outils.h"
+
+#include <limits.h>
+
+int test_creer_concatenation_des_automates(){
+	int result = 1;
+
+	{
+		// a* . b
+		Automate * automate_1 = creer_automate();
+		ajouter_transition( automate_1, 0, 'a', 0 );
+		ajouter_etat_initial( automate_1, 0 );
+		ajouter_etat_final( automate_1, 0 );
+
+		Automate * automate_2 = mot_to_automate( "b" );
+
+		Automate * concat = creer_concatenation_des_automates(
+			automate_1, automate_2 
+		);
+
+		TEST(
+			1
+			&& concat
+			&& le_mot_est_reconnu( concat, "b" )
+			&& le_mot_est_reconnu( concat, "ab" )
+			&& le_mot_est_reconnu( concat, "aaab" )
+			&& ! le_mot_est_reconnu( concat, "" )
+			&& ! le_mot_est_reconnu( concat, "a" )
+			&& ! le_mot_est_reconnu( concat, "ba" )
+			&& ! le_mot_est_reconnu( concat, "bb" )
+			, result
+		);
+		liberer_automate( concat );
+
+		// b . a*
+		concat = creer_concatenation_des_automates( automate_2, automate_1 );
+		TEST(
+			1
+			&& concat
+			&& le_mot_est_reconnu( concat, "b" )
+			&& le_mot_est_reconnu( concat, "ba" )
+			&& le_mot_est_reconnu( concat, "baaa" )
+			&& ! le_mot_est_reconnu( concat, "" )
+			&& ! le_mot_est_reconnu( concat, "ab" )
+			&& ! le_mot_est_reconnu( concat, "bb" )
+			, result
+		);
+		liberer_automate( concat );
+
+		liberer_automate( automate_1 );
+		liberer_automate( automate_2 );
+	}
+
+	{
+		Automate * automate_1 = mot_to_automate( "ab" );
+		Automate * automate_2 = mot_to_automate( "ab" );
+		Automate * concat = creer_concatenation_des_automates(
+			automate_1, automate_2 
+		);
+		TEST(
+			1
+			&& le_mot_est_reconnu( concat, "abab" )
+			&& ! le_mot_est_reconnu( concat, "ab" )
+			&& ! le_mot_est_reconnu( concat, "aabb" )
+			, result
+		);
+		liberer_automate( concat );
+		liberer_automate( automate_1 );
+		liberer_automate( automate_2 );
+	}
+
+	return result;
+}
+
+int test_creer_etoile_automate(){
+	int result = 1;
+
+	{
+		Automate * automate = mot_to_automate( "ab" );
+		Automate * etoile = creer_etoile_automate( automate );
+
+		TEST(
+			1
+			&& etoile
+			&& le_mot_est_reconnu( etoile, "" )
+			&& le_mot_est_reconnu( etoile, "ab" )
+			&& le_mot_est_reconnu( etoile, "abab" )
+			&& le_mot_est_reconnu( etoile, "ababab" )
+			&& ! le_mot_est_reconnu( etoile, "a" )
+			&& ! le_mot_est_reconnu( etoile, "aba" )
+			&& ! le_mot_est_reconnu( etoile, "ba" )
+			&& ! le_mot_est_reconnu( etoile, "abb" )
+			, result
+		);
+		liberer_automate( etoile );
+		liberer_automate( automate );
+	}
+
+	{
+		// a(ba)* : revenir sur l'état initial ne doit pas rendre "aba" 
+		// final avant d'avoir lu un mot complet
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 0 );
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 1 );
+
+		Automate * etoile = creer_etoile_automate( automate );
+		TEST(
+			1
+			&& le_mot_est_reconnu( etoile, "" )
+			&& le_mot_est_reconnu( etoile, "a" )
+			&& le_mot_est_reconnu( etoile, "aa" )
+			&& le_mot_est_reconnu( etoile, "aba" )
+			&& le_mot_est_reconnu( etoile, "abaa" )
+			&& ! le_mot_est_reconnu( etoile, "ab" )
+			&& ! le_mot_est_reconnu( etoile, "b" )
+			, result
+		);
+		liberer_automate( etoile );
+		liberer_automate( automate );
+	}
+
+	{
+		Automate * vide = creer_automate();
+		Automate * etoile = creer_etoile_automate( vide );
+		TEST(
+			1
+			&& le_mot_est_reconnu( etoile, "" )
+			&& ! le_mot_est_reconnu( etoile, "a" )
+			, result
+		);
+		liberer_automate( etoile );
+		liberer_automate( vide );
+	}
+
+	{
+		// Le plus grand état vaut INT_MAX : le nouvel état doit être pris
+		// ailleurs.
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 0, 'a', INT_MAX );
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, INT_MAX );
+		Automate * etoile = creer_etoile_automate( automate );
+		TEST(
+			1
+			&& le_mot_est_reconnu( etoile, "" )
+			&& le_mot_est_reconnu( etoile, "a" )
+			&& le_mot_est_reconnu( etoile, "aaa" )
+			&& ! le_mot_est_reconnu( etoile, "b" )
+			&& taille_ensemble( get_etats( etoile ) ) == 3
+			&& get_max_etat( etoile ) == INT_MAX
+			&& get_min_etat( etoile ) == -1
+			, result
+		);
+		liberer_automate( etoile );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_creer_concatenation_des_automates() ){ return 1; };
+	if( ! test_creer_etoile_automate() ){ return 1; };
+
+	return 0;
+	
+}
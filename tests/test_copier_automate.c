@@ -0,0 +1,144 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "automate.h"
+#include "outils.h"
+
+int test_copier_automate(){
+	int result = 1;
+
+	{
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 0 );
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 1 );
+
+		Automate * copie_1 = copier_automate( automate );
+		Automate * copie_2 = copier_automate( copie_1 );
+
+		// Modifier une copie ne modifie ni l'original ni l'autre copie
+		ajouter_transition( copie_1, 1, 'a', 2 );
+		ajouter_transition( copie_1, 0, 'a', 2 );
+		ajouter_etat_final( copie_1, 2 );
+
+		TEST(
+			1
+			&& le_mot_est_reconnu( copie_1, "aa" )
+			&& le_mot_est_reconnu( copie_1, "a" )
+			&& ! le_mot_est_reconnu( automate, "aa" )
+			&& ! le_mot_est_reconnu( copie_2, "aa" )
+			&& ! est_un_etat_de_l_automate( automate, 2 )
+			&& ! est_un_etat_de_l_automate( copie_2, 2 )
+			&& taille_destinations( voisins( automate, 0, 'a' ) ) == 1
+			&& taille_destinations( voisins( copie_1, 0, 'a' ) ) == 2
+			, result
+		);
+
+		// Modifier l'original ne modifie pas les copies
+		ajouter_transition( automate, 0, 'b', 1 );
+		TEST(
+			1
+			&& le_mot_est_reconnu( automate, "b" )
+			&& ! le_mot_est_reconnu( copie_1, "b" )
+			&& ! le_mot_est_reconnu( copie_2, "b" )
+			&& le_mot_est_reconnu( copie_2, "aba" )
+			, result
+		);
+
+		// Les automates peuvent être libérés dans n'importe quel ordre
+		liberer_automate( automate );
+		TEST( le_mot_est_reconnu( copie_2, "a" ), result );
+		liberer_automate( copie_2 );
+		TEST( le_mot_est_reconnu( copie_1, "a" ), result );
+		liberer_automate( copie_1 );
+	}
+
+	{
+		Automate * automate = mot_to_automate( "abc" );
+		Automate * copie = copier_automate( automate );
+		liberer_automate( automate );
+		ajouter_transition( copie, 3, 'd', 4 );
+		ajouter_etat_final( copie, 4 );
+		TEST(
+			1
+			&& le_mot_est_reconnu( copie, "abc" )
+			&& le_mot_est_reconnu( copie, "abcd" )
+			, result
+		);
+		liberer_automate( copie );
+	}
+
+	return result;
+}
+
+int test_cloner_automate(){
+	int result = 1;
+
+	{
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 0 );
+		ajouter_transition( automate, 1, 'b', 2 );
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 2 );
+
+		Automate * clone = cloner_automate( automate );
+		liberer_automate( automate );
+
+		TEST(
+			1
+			&& le_mot_est_reconnu( clone, "ab" )
+			&& le_mot_est_reconnu( clone, "abab" )
+			&& ! le_mot_est_reconnu( clone, "a" )
+			&& taille_destinations( voisins( clone, 1, 'b' ) ) == 2
+			, result
+		);
+
+		Automate * copie = copier_automate( clone );
+		Automate * clone_de_copie = cloner_automate( copie );
+		ajouter_transition( clone_de_copie, 2, 'c', 2 );
+		TEST(
+			1
+			&& le_mot_est_reconnu( clone_de_copie, "abc" )
+			&& ! le_mot_est_reconnu( copie, "abc" )
+			&& ! le_mot_est_reconnu( clone, "abc" )
+			, result
+		);
+
+		liberer_automate( clone );
+		liberer_automate( copie );
+		liberer_automate( clone_de_copie );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_copier_automate() ){ return 1; };
+	if( ! test_cloner_automate() ){ return 1; };
+
+	return 0;
+	
+}
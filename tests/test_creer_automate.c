@@ -25,6 +25,7 @@
 
 #include <signal.h>
 #include <errno.h>
+#include <limits.h>
 
 int test_creer_automate(){
 
@@ -131,9 +132,62 @@ int test_creer_automate(){
 }
 
 
+typedef struct {
+	int nb;
+	int origines[8];
+	char lettres[8];
+} Transitions_lues;
+
+void lire_transition( int origine, char lettre, int fin, void* data ){
+	Transitions_lues * lues = (Transitions_lues*) data;
+	lues->origines[ lues->nb ] = origine;
+	lues->lettres[ lues->nb ] = lettre;
+	lues->nb++;
+}
+
+int test_cles_des_transitions(){
+	int result = 1;
+
+	// Origines négatives ou nulles, lettres de part et d'autre de 0
+	Automate * automate = creer_automate();
+	ajouter_transition( automate, 0, 'a', 1 );
+	ajouter_transition( automate, -1, 'b', 0 );
+	ajouter_transition( automate, -1, (char) 200, 0 );
+	ajouter_transition( automate, INT_MAX, 'z', INT_MIN );
+	ajouter_transition( automate, INT_MIN, 'a', INT_MAX );
+	ajouter_transition( automate, 0, '\0', 0 );
+
+	TEST( est_une_transition_de_l_automate( automate, -1, (char) 200, 0 ), result );
+	TEST( est_une_transition_de_l_automate( automate, INT_MIN, 'a', INT_MAX ), result );
+	TEST( est_une_transition_de_l_automate( automate, INT_MAX, 'z', INT_MIN ), result );
+	TEST( est_une_transition_de_l_automate( automate, 0, '\0', 0 ), result );
+	TEST( ! est_une_transition_de_l_automate( automate, 0, 'b', 0 ), result );
+
+	Transitions_lues lues;
+	lues.nb = 0;
+	pour_toute_transition( automate, lire_transition, &lues );
+	TEST( lues.nb == 6, result );
+	int i;
+	for( i=1; i<lues.nb; i++ ){
+		TEST(
+			lues.origines[i-1] < lues.origines[i] 
+			|| ( 
+				lues.origines[i-1] == lues.origines[i] 
+				&& lues.lettres[i-1] < lues.lettres[i] 
+			), 
+			result 
+		);
+	}
+	TEST( lues.origines[0] == INT_MIN && lues.origines[5] == INT_MAX, result );
+
+	liberer_automate( automate );
+	return result;
+}
+
 int main(){
 
 	if( ! test_creer_automate() ){ return 1; }
+	if( ! test_cles_des_transitions() ){ return 1; }
 
 	return 0;
 }
@@ -136,10 +136,75 @@ int test_delta_delta_star(){
 	return result;
 }
 
+int test_est_deterministe(){
+	int result = 1;
+
+	Automate* automate = creer_automate();
+	ajouter_transition( automate, 0, 'a', 1 );
+	ajouter_transition( automate, 1, 'b', 0 );
+	ajouter_transition( automate, 1, 'a', 1 );
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, 1 );
+
+	TEST( est_deterministe( automate ), result );
+	TEST( le_mot_est_reconnu( automate, "aaba" ), result );
+	TEST( ! le_mot_est_reconnu( automate, "ab" ), result );
+	TEST( ! le_mot_est_reconnu( automate, "" ), result );
+	TEST( ! le_mot_est_reconnu( automate, "ac" ), result );
+
+	// Ajouter une transition déjà présente ne change rien
+	ajouter_transition( automate, 0, 'a', 1 );
+	TEST( est_deterministe( automate ), result );
+
+	Automate* copie = copier_automate( automate );
+
+	ajouter_transition( automate, 1, 'b', 2 );
+	ajouter_transition( automate, 1, 'b', 3 );
+	TEST( ! est_deterministe( automate ), result );
+	TEST( est_deterministe( copie ), result );
+	ajouter_transition( automate, 2, 'a', 1 );
+	TEST( le_mot_est_reconnu( automate, "aba" ), result );
+	TEST( ! le_mot_est_reconnu( automate, "ab" ), result );
+
+	Automate* clone = cloner_automate( automate );
+	TEST( ! est_deterministe( clone ), result );
+
+	// Plusieurs états initiaux
+	ajouter_etat_initial( copie, 1 );
+	TEST( ! est_deterministe( copie ), result );
+	TEST( le_mot_est_reconnu( copie, "" ), result );
+	TEST( le_mot_est_reconnu( copie, "ba" ), result );
+	TEST( ! le_mot_est_reconnu( copie, "bb" ), result );
+
+	// Ajout en masse, sur un automate vide puis sur un automate existant
+	Automate* masse = creer_automate();
+	int origines[] = { 0, 0, 1 };
+	char lettres[] = { 'a', 'b', 'a' };
+	int fins[] = { 1, 1, 0 };
+	ajouter_transitions_en_masse( masse, origines, lettres, fins, 3 );
+	TEST( est_deterministe( masse ), result );
+	int autres_fins[] = { 2, 1, 0 };
+	ajouter_transitions_en_masse( masse, origines, lettres, autres_fins, 3 );
+	TEST( ! est_deterministe( masse ), result );
+
+	Ensemble * depart = creer_ensemble( NULL, NULL, NULL );
+	ajouter_element( depart, 0 );
+	Ensemble * arrivee = delta_star( masse, depart, "a" );
+	TEST( taille_ensemble( arrivee ) == 2, result );
+
+	liberer_ensemble( arrivee );
+	liberer_ensemble( depart );
+	liberer_automate( masse );
+	liberer_automate( clone );
+	liberer_automate( copie );
+	liberer_automate( automate );
+	return result;
+}
 
 int main(){
 
 	if( ! test_delta_delta_star() ){ return 1; }
+	if( ! test_est_deterministe() ){ return 1; }
 
 	return 0;
 }
@@ -0,0 +1,188 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "destinations.h"
+#include "outils.h"
+
+#include <string.h>
+
+int destinations_conformes( const Destinations * d, const int * attendus, int n ){
+	int i;
+	if( taille_destinations( d ) != n ) return 0;
+	for( i=0; i<n; i++ ){
+		if( etats_destinations( d )[i] != attendus[i] ) return 0;
+	}
+	return 1;
+}
+
+int test_ajouter_destination(){
+	int result = 1;
+	int i, ajoute;
+
+	Destinations * d = creer_destinations();
+	TEST( taille_destinations( d ) == 0, result );
+	TEST( ! contient_destination( d, 0 ), result );
+
+	// Les premiers états restent dans la structure
+	ajoute = ajouter_destination( d, 5 );
+	TEST( ajoute, result );
+	ajoute = ajouter_destination( d, 5 );
+	TEST( ! ajoute, result );
+	ajouter_destination( d, 2 );
+	int petits[] = { 2, 5 };
+	TEST( destinations_conformes( d, petits, 2 ), result );
+	TEST( d->capacite == 0, result );
+
+	// Au-delà, ils sont déplacés dans un tableau alloué
+	ajouter_destination( d, 3 );
+	int trois[] = { 2, 3, 5 };
+	TEST( destinations_conformes( d, trois, 3 ), result );
+	TEST( d->capacite >= 3, result );
+
+	for( i=100; i>=0; i-- ){
+		ajouter_destination( d, i );
+	}
+	TEST( taille_destinations( d ) == 101, result );
+	for( i=0; i<=100; i++ ){
+		TEST( etats_destinations( d )[i] == i, result );
+	}
+	TEST( contient_destination( d, 0 ), result );
+	TEST( contient_destination( d, 100 ), result );
+	TEST( ! contient_destination( d, 101 ), result );
+	TEST( ! contient_destination( d, -1 ), result );
+
+	liberer_destinations( d );
+	return result;
+}
+
+int test_ajouter_destinations_triees(){
+	int result = 1;
+
+	int etats[] = { 1, 4, 7, 9 };
+	Destinations * d = creer_destinations();
+	ajouter_destinations_triees( d, etats, 4 );
+	TEST( destinations_conformes( d, etats, 4 ), result );
+
+	int autres[] = { 0, 4, 8 };
+	ajouter_destinations_triees( d, autres, 3 );
+	int union_attendue[] = { 0, 1, 4, 7, 8, 9 };
+	TEST( destinations_conformes( d, union_attendue, 6 ), result );
+	liberer_destinations( d );
+
+	d = creer_destinations();
+	ajouter_destinations_triees( d, etats, 2 );
+	TEST( destinations_conformes( d, etats, 2 ), result );
+	TEST( d->capacite == 0, result );
+	liberer_destinations( d );
+
+	return result;
+}
+
+int test_copier_et_comparer_destinations(){
+	int result = 1;
+	int i;
+
+	Destinations * d1 = creer_destinations();
+	for( i=0; i<10; i++ ){
+		ajouter_destination( d1, 2*i );
+	}
+	Destinations * d2 = copier_destinations( d1 );
+	TEST( comparer_destinations( d1, d2 ) == 0, result );
+	TEST( etats_destinations( d1 ) != etats_destinations( d2 ), result );
+
+	// La copie est indépendante de l'original
+	ajouter_destination( d2, 1 );
+	TEST( taille_destinations( d1 ) == 10, result );
+	TEST( ! contient_destination( d1, 1 ), result );
+	TEST( comparer_destinations( d1, d2 ) != 0, result );
+	TEST( 
+		comparer_destinations( d1, d2 ) == - comparer_destinations( d2, d1 ),
+		result
+	);
+
+	Destinations * vide = creer_destinations();
+	Destinations * singleton = creer_destinations();
+	ajouter_destination( singleton, 3 );
+	Destinations * copie = copier_destinations( singleton );
+	TEST( comparer_destinations( singleton, copie ) == 0, result );
+	TEST( comparer_destinations( vide, singleton ) < 0, result );
+	TEST( comparer_destinations( singleton, vide ) > 0, result );
+
+	Ensemble * ens = creer_ensemble( NULL, NULL, NULL );
+	ajouter_destinations_a_ensemble( ens, d1 );
+	TEST( taille_ensemble( ens ) == 10, result );
+	TEST( est_dans_l_ensemble( ens, 18 ), result );
+
+	liberer_ensemble( ens );
+	liberer_destinations( copie );
+	liberer_destinations( singleton );
+	liberer_destinations( vide );
+	liberer_destinations( d2 );
+	liberer_destinations( d1 );
+	return result;
+}
+
+int test_destinations_sur_place(){
+	int result = 1;
+	int i;
+
+	// Une structure remplie de zéros est un ensemble vide
+	Destinations d;
+	memset( &d, 0, sizeof(Destinations) );
+	TEST( taille_destinations( &d ) == 0, result );
+	for( i=0; i<5; i++ ){
+		ajouter_destination( &d, i );
+	}
+
+	// Une copie octet par octet partage le tableau alloué jusqu'à ce qu'elle
+	// soit détachée
+	Destinations copie = d;
+	TEST( etats_destinations( &copie ) == etats_destinations( &d ), result );
+	detacher_destinations( &copie );
+	TEST( etats_destinations( &copie ) != etats_destinations( &d ), result );
+	TEST( comparer_destinations( &copie, &d ) == 0, result );
+
+	vider_destinations( &copie );
+	TEST( taille_destinations( &copie ) == 0, result );
+	TEST( taille_destinations( &d ) == 5, result );
+	ajouter_destination( &copie, 9 );
+	TEST( contient_destination( &copie, 9 ), result );
+
+	vider_destinations( &copie );
+	vider_destinations( &d );
+	initialiser_destinations( &d );
+	TEST( taille_destinations( &d ) == 0, result );
+	return result;
+}
+
+int main(){
+	int result = 1;
+
+	result &= test_ajouter_destination();
+	result &= test_ajouter_destinations_triees();
+	result &= test_copier_et_comparer_destinations();
+	result &= test_destinations_sur_place();
+
+	if( ! result ){ return 1; }
+	return 0;
+}
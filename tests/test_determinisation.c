@@ -0,0 +1,218 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "automate.h"
+#include "determinisation.h"
+#include "expression.h"
+#include "outils.h"
+
+typedef struct {
+	const Automate * automate;
+	int inclus;
+} Verification;
+
+void action_verifier_transition( int origine, char lettre, int fin, void* data ){
+	Verification * verification = (Verification *) data;
+	if( ! est_une_transition_de_l_automate( verification->automate, origine, lettre, fin ) ){
+		verification->inclus = 0;
+	}
+}
+
+int automates_identiques( const Automate * a1, const Automate * a2 ){
+	Verification v1 = { a2, 1 };
+	Verification v2 = { a1, 1 };
+	pour_toute_transition( a1, action_verifier_transition, &v1 );
+	pour_toute_transition( a2, action_verifier_transition, &v2 );
+	return 
+		v1.inclus && v2.inclus
+		&& comparer_ensemble( get_etats( a1 ), get_etats( a2 ) ) == 0
+		&& comparer_ensemble( get_alphabet( a1 ), get_alphabet( a2 ) ) == 0
+		&& comparer_ensemble( get_initiaux( a1 ), get_initiaux( a2 ) ) == 0
+		&& comparer_ensemble( get_finaux( a1 ), get_finaux( a2 ) ) == 0;
+}
+
+void action_verifier_determinisme( int origine, char lettre, int fin, void* data ){
+	Verification * verification = (Verification *) data;
+	if( taille_destinations( voisins( verification->automate, origine, lettre ) ) != 1 ){
+		verification->inclus = 0;
+	}
+}
+
+int verifier_determinisme( const Automate * automate ){
+	Verification v = { automate, 1 };
+	pour_toute_transition( automate, action_verifier_determinisme, &v );
+	return v.inclus && taille_ensemble( get_initiaux( automate ) ) <= 1;
+}
+
+/*
+ * Vérifie que les deux automates reconnaissent les mêmes mots parmi tous les
+ * mots de longueur au plus 'longueur' sur l'alphabet {a, b, c}.
+ */
+int memes_mots( const Automate * a1, const Automate * a2, int longueur ){
+	char mot[16];
+	int n, i;
+	for( n=0; n<=longueur; n++ ){
+		int nb_mots = 1;
+		for( i=0; i<n; i++ ) nb_mots *= 3;
+		int m;
+		for( m=0; m<nb_mots; m++ ){
+			int code = m;
+			for( i=0; i<n; i++ ){
+				mot[i] = 'a' + code % 3;
+				code /= 3;
+			}
+			mot[n] = '\0';
+			if( le_mot_est_reconnu( a1, mot ) != le_mot_est_reconnu( a2, mot ) ){
+				return 0;
+			}
+		}
+	}
+	return 1;
+}
+
+int test_determinisation(){
+	int result = 1;
+
+	{
+		// Les mots dont l'antépénultième lettre est un a
+		Automate * automate = regex_to_automate( "(a|b)*a(a|b)(a|b)" );
+		Automate * deterministe = creer_automate_deterministe( automate );
+		Automate * parallele = creer_automate_deterministe_parallele( automate, 4 );
+		Table * numeros = compacter_automate( parallele );
+
+		TEST(
+			1
+			&& verifier_determinisme( deterministe )
+			&& est_deterministe( deterministe )
+			&& verifier_determinisme( parallele )
+			&& est_deterministe( parallele )
+			&& taille_ensemble( get_etats( deterministe ) ) == 9
+			&& est_un_etat_initial_de_l_automate( deterministe, 0 )
+			&& memes_mots( automate, deterministe, 7 )
+			&& automates_identiques( deterministe, parallele )
+			, result
+		);
+
+		liberer_table( numeros );
+		liberer_automate( automate );
+		liberer_automate( deterministe );
+		liberer_automate( parallele );
+	}
+
+	{
+		// Des automates non déterministes aléatoires
+		int essai;
+		for( essai = 0; essai < 20; essai++ ){
+			Automate * automate = creer_automate();
+			int i;
+			for( i=0; i<60; i++ ){
+				ajouter_transition( 
+					automate, rand() % 20, 'a' + rand() % 3, rand() % 20 
+				);
+			}
+			ajouter_etat_initial( automate, 0 );
+			ajouter_etat_initial( automate, rand() % 20 );
+			ajouter_etat_final( automate, rand() % 20 );
+			ajouter_etat_final( automate, rand() % 20 );
+
+			Automate * deterministe = creer_automate_deterministe( automate );
+			Automate * parallele = creer_automate_deterministe_parallele( 
+				automate, 1 + essai % 4 
+			);
+			Table * numeros = compacter_automate( parallele );
+			Table * numeros_sequentiel = compacter_automate( deterministe );
+
+			TEST(
+				1
+				&& verifier_determinisme( deterministe )
+				&& est_deterministe( deterministe )
+				&& memes_mots( automate, deterministe, 5 )
+				&& automates_identiques( deterministe, parallele )
+				, result
+			);
+
+			liberer_table( numeros );
+			liberer_table( numeros_sequentiel );
+			liberer_automate( automate );
+			liberer_automate( deterministe );
+			liberer_automate( parallele );
+		}
+	}
+
+	{
+		// Sans état initial, l'automate ne reconnaît aucun mot
+		Automate * automate = mot_to_automate( "ab" );
+		Automate * vide = creer_automate();
+		ajouter_elements( vide->alphabet, get_alphabet( automate ) );
+		Automate * deterministe = creer_automate_deterministe( vide );
+		Automate * parallele = creer_automate_deterministe_parallele( vide, 0 );
+
+		TEST(
+			1
+			&& taille_ensemble( get_etats( deterministe ) ) == 0
+			&& ! le_mot_est_reconnu( deterministe, "" )
+			&& automates_identiques( deterministe, parallele )
+			, result
+		);
+
+		liberer_automate( automate );
+		liberer_automate( vide );
+		liberer_automate( deterministe );
+		liberer_automate( parallele );
+	}
+
+	return result;
+}
+
+
+int test_determinisation_sans_initial(){
+	int result = 1;
+
+	Automate * automate = creer_automate();
+	ajouter_transition( automate, 0, 'a', 1 );
+	ajouter_transition( automate, 1, 'b', 0 );
+	ajouter_etat_final( automate, 1 );
+
+	// L'ensemble vide n'est jamais un état
+	Automate * deterministe = creer_automate_deterministe( automate );
+	Automate * parallele = creer_automate_deterministe_parallele( automate, 2 );
+	TEST( taille_ensemble( get_etats( deterministe ) ) == 0, result );
+	TEST( taille_ensemble( get_initiaux( deterministe ) ) == 0, result );
+	TEST( taille_ensemble( get_etats( parallele ) ) == 0, result );
+	TEST( taille_ensemble( get_initiaux( parallele ) ) == 0, result );
+	TEST( ! le_mot_est_reconnu( deterministe, "" ), result );
+	TEST( ! le_mot_est_reconnu( parallele, "a" ), result );
+
+	liberer_automate( parallele );
+	liberer_automate( deterministe );
+	liberer_automate( automate );
+	return result;
+}
+
+int main(){
+
+	if( ! test_determinisation() ){ return 1; };
+	if( ! test_determinisation_sans_initial() ){ return 1; };
+
+	return 0;
+	
+}
@@ -22,6 +22,7 @@
 #include "automate.h"
 #include "outils.h"
 
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -534,6 +535,17 @@ int test_comparer_ensemble(){
 	liberer_ensemble( ens1 );
 	liberer_ensemble( ens2 );
 
+	// Les éléments extrêmes ne doivent pas déborder lors de la comparaison
+	ens1 = creer_ensemble( NULL, NULL, NULL );
+	ens2 = creer_ensemble( NULL, NULL, NULL );
+	ajouter_element( ens1, INT_MIN );
+	ajouter_element( ens2, INT_MAX );
+	TEST( comparer_ensemble(ens1, ens2) == -1, result );
+	TEST( comparer_ensemble(ens2, ens1) == 1, result );
+
+	liberer_ensemble( ens1 );
+	liberer_ensemble( ens2 );
+
 	return result;
 }
 
@@ -609,6 +621,162 @@ int test_copier_ensemble(){
 	return result;
 }
 
+int test_curseur_ensemble(){
+	int result = 1;
+	int i;
+
+	Ensemble * ens = creer_ensemble( NULL, NULL, NULL );
+	TEST( curseur_ensemble_est_vide( premier_curseur_ensemble( ens ) ), result );
+	for( i=0; i<100; i++ ){
+		ajouter_element( ens, ( i * 37 ) % 100 );
+	}
+	for( i=0; i<100; i+=2 ){
+		retirer_element( ens, i );
+	}
+
+	Ensemble_curseur c;
+	i = 1;
+	for(
+		c = premier_curseur_ensemble( ens );
+		! curseur_ensemble_est_vide( c );
+		c = curseur_suivant_ensemble( c )
+	){
+		TEST( get_element_curseur( c ) == i, result );
+		i += 2;
+	}
+	TEST( i == 101, result );
+	for(
+		c = dernier_curseur_ensemble( ens );
+		! curseur_ensemble_est_vide( c );
+		c = curseur_precedent_ensemble( c )
+	){
+		i -= 2;
+		TEST( get_element_curseur( c ) == i, result );
+	}
+	TEST( i == 1, result );
+
+	liberer_ensemble( ens );
+	return result;
+}
+
+int test_hash_ensemble(){
+	int result = 1;
+	int i;
+
+	Ensemble * ens1 = creer_ensemble( NULL, NULL, NULL );
+	Ensemble * ens2 = creer_ensemble( NULL, NULL, NULL );
+	TEST( hash_ensemble( ens1 ) == 0, result );
+	TEST( ensembles_egaux( ens1, ens2 ), result );
+
+	// L'empreinte ne dépend pas de l'ordre des ajouts ...
+	for( i=0; i<50; i++ ){
+		ajouter_element( ens1, i );
+		ajouter_element( ens2, 49-i );
+	}
+	TEST( hash_ensemble( ens1 ) == hash_ensemble( ens2 ), result );
+	TEST( ensembles_egaux( ens1, ens2 ), result );
+
+	// ... ni des ajouts et retraits inutiles
+	uint64_t hash = hash_ensemble( ens1 );
+	ajouter_element( ens1, 10 );
+	retirer_element( ens1, 1000 );
+	TEST( hash_ensemble( ens1 ) == hash, result );
+
+	retirer_element( ens1, 10 );
+	TEST( hash_ensemble( ens1 ) != hash, result );
+	TEST( ! ensembles_egaux( ens1, ens2 ), result );
+	ajouter_element( ens1, 10 );
+	TEST( hash_ensemble( ens1 ) == hash, result );
+
+	// Même taille, contenus différents
+	retirer_element( ens2, 0 );
+	ajouter_element( ens2, 100 );
+	TEST( taille_ensemble( ens1 ) == taille_ensemble( ens2 ), result );
+	TEST( ! ensembles_egaux( ens1, ens2 ), result );
+
+	// Copies, échanges et ajouts en masse
+	Ensemble * copie = copier_ensemble( ens1 );
+	Ensemble * clone = cloner_ensemble( ens2 );
+	TEST( hash_ensemble( copie ) == hash, result );
+	TEST( ensembles_egaux( clone, ens2 ), result );
+	swap_ensemble( copie, clone );
+	TEST( ensembles_egaux( copie, ens2 ), result );
+	TEST( ensembles_egaux( clone, ens1 ), result );
+
+	intptr_t tries[50];
+	for( i=0; i<50; i++ ){
+		tries[i] = i;
+	}
+	Ensemble * ens3 = creer_ensemble( NULL, NULL, NULL );
+	ajouter_elements_tries( ens3, tries, 50 );
+	TEST( ensembles_egaux( ens3, ens1 ), result );
+	ajouter_elements_tries( ens3, tries, 50 );
+	TEST( hash_ensemble( ens3 ) == hash, result );
+
+	vider_ensemble( ens3 );
+	TEST( hash_ensemble( ens3 ) == 0, result );
+
+	liberer_ensemble( ens1 );
+	liberer_ensemble( ens2 );
+	liberer_ensemble( ens3 );
+	liberer_ensemble( copie );
+	liberer_ensemble( clone );
+
+	return result;
+}
+
+int test_cloner_ensemble(){
+	int result = 1;
+	int i;
+
+	Ensemble * ens1 = creer_ensemble( NULL, NULL, NULL );
+	for( i=0; i<100; i++ ){
+		ajouter_element( ens1, 3*i );
+	}
+	Ensemble * ens2 = cloner_ensemble( ens1 );
+
+	TEST( ens1 != ens2, result );
+	TEST( comparer_ensemble( ens1, ens2 ) == 0, result );
+
+	// Les deux ensembles sont indépendants
+	retirer_element( ens1, 0 );
+	ajouter_element( ens2, 1 );
+	TEST( est_dans_l_ensemble( ens2, 0 ), result );
+	TEST( ! est_dans_l_ensemble( ens1, 1 ), result );
+	TEST( taille_ensemble( ens1 ) == 99, result );
+	TEST( taille_ensemble( ens2 ) == 101, result );
+
+	liberer_ensemble( ens1 );
+	liberer_ensemble( ens2 );
+
+
+	ens1 = creer_ensemble(
+		(int (*)( const intptr_t, const intptr_t)) comparer_elmt, 
+		(intptr_t (*)( const intptr_t )) copier_elmt, 
+		(void (*)( intptr_t )) supprimer_elmt
+	);
+
+	Elmt elmt;
+	for( i=0; i<10; i++ ){
+		initialiser_elmt( &elmt, i );
+		ajouter_element( ens1, (intptr_t) &elmt );
+	}
+	ens2 = cloner_ensemble( ens1 );
+
+	TEST( comparer_ensemble( ens1, ens2 ) == 0, result );
+	// Les éléments ont été copiés
+	TEST(
+		get_element( premier_iterateur_ensemble( ens1 ) ) != 
+		get_element( premier_iterateur_ensemble( ens2 ) ), 
+		result
+	);
+
+	liberer_ensemble( ens1 );
+	liberer_ensemble( ens2 );
+
+	return result;
+}
+
 typedef struct {
 	int min;
 	int max;
@@ -953,6 +1121,9 @@ int main(){
 	result &= test_taille_ensemble();
 	result &= test_comparer_ensemble();
 	result &= test_copier_ensemble();
+	result &= test_cloner_ensemble();
+	result &= test_hash_ensemble();
+	result &= test_curseur_ensemble();
 	result &= test_pour_tout_element();
 //	result &= test_print_ensemble();
 	result &= test_swap_ensemble();
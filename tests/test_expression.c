@@ -0,0 +1,149 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "automate.h"
+#include "expression.h"
+#include "outils.h"
+
+int test_expression(){
+	int result = 1;
+
+	{
+		Automate * automate = regex_to_automate( "a(b|c)*d" );
+
+		TEST(
+			1
+			&& automate
+			&& taille_ensemble( get_etats( automate ) ) == 5
+			&& taille_ensemble( get_initiaux( automate ) ) == 1
+			&& est_un_etat_initial_de_l_automate( automate, 0 )
+			&& est_une_transition_de_l_automate( automate, 0, 'a', 1 )
+			&& est_une_transition_de_l_automate( automate, 2, 'c', 3 )
+			&& est_un_etat_final_de_l_automate( automate, 4 )
+			&& le_mot_est_reconnu( automate, "ad" )
+			&& le_mot_est_reconnu( automate, "abd" )
+			&& le_mot_est_reconnu( automate, "acbbcd" )
+			&& ! le_mot_est_reconnu( automate, "" )
+			&& ! le_mot_est_reconnu( automate, "abc" )
+			&& ! le_mot_est_reconnu( automate, "bd" )
+			, result
+		);
+
+		if( automate ) liberer_automate( automate );
+	}
+
+	{
+		Automate * automate = regex_to_automate( "[a-cx]+y?|z*" );
+
+		TEST(
+			1
+			&& automate
+			&& taille_ensemble( get_etats( automate ) ) == 4
+			&& taille_ensemble( get_alphabet( automate ) ) == 6
+			&& le_mot_est_reconnu( automate, "" )
+			&& le_mot_est_reconnu( automate, "zzz" )
+			&& le_mot_est_reconnu( automate, "abxc" )
+			&& le_mot_est_reconnu( automate, "by" )
+			&& ! le_mot_est_reconnu( automate, "y" )
+			&& ! le_mot_est_reconnu( automate, "ayy" )
+			&& ! le_mot_est_reconnu( automate, "az" )
+			&& ! le_mot_est_reconnu( automate, "d" )
+			, result
+		);
+
+		if( automate ) liberer_automate( automate );
+	}
+
+	{
+		Automate * automate = regex_to_automate( "\\*\\[(a|)[\\-\\]]" );
+
+		TEST(
+			1
+			&& automate
+			&& taille_ensemble( get_etats( automate ) ) == 5
+			&& le_mot_est_reconnu( automate, "*[-" )
+			&& le_mot_est_reconnu( automate, "*[a]" )
+			&& ! le_mot_est_reconnu( automate, "*[a" )
+			&& ! le_mot_est_reconnu( automate, "*[." )
+			, result
+		);
+
+		if( automate ) liberer_automate( automate );
+	}
+
+	{
+		Automate * automate = regex_to_automate( "" );
+
+		TEST(
+			1
+			&& automate
+			&& taille_ensemble( get_etats( automate ) ) == 1
+			&& le_mot_est_reconnu( automate, "" )
+			&& ! le_mot_est_reconnu( automate, "a" )
+			, result
+		);
+
+		if( automate ) liberer_automate( automate );
+	}
+
+	{
+		// Le même langage que celui construit à la main
+		Automate * automate = regex_to_automate( "(ab)*" );
+		Automate * mot = mot_to_automate( "ab" );
+		Automate * etoile = creer_etoile_automate( mot );
+
+		TEST(
+			1
+			&& automate
+			&& le_mot_est_reconnu( automate, "ababab" ) 
+				== le_mot_est_reconnu( etoile, "ababab" )
+			&& le_mot_est_reconnu( automate, "aba" ) 
+				== le_mot_est_reconnu( etoile, "aba" )
+			, result
+		);
+
+		if( automate ) liberer_automate( automate );
+		liberer_automate( mot );
+		liberer_automate( etoile );
+	}
+
+	{
+		const char * erreurs[] = {
+			"(", "a)", "*a", "a|*", "[z-a]", "[]", "[ab", "a\\", "(a))", "a(|"
+		};
+		int i;
+		for( i=0; i<(int)( sizeof(erreurs) / sizeof(erreurs[0]) ); i++ ){
+			TEST( ! regex_to_automate( erreurs[i] ), result );
+		}
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_expression() ){ return 1; };
+
+	return 0;
+	
+}
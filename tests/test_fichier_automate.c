@@ -0,0 +1,342 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "automate.h"
+#include "fichier_automate.h"
+#include "outils.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define FICHIER_TEST "test_fichier_automate.bin"
+
+int automates_identiques( const Automate * a1, const Automate * a2 ){
+	return 
+		comparer_ensemble( get_etats( a1 ), get_etats( a2 ) ) == 0
+		&& comparer_ensemble( get_alphabet( a1 ), get_alphabet( a2 ) ) == 0
+		&& comparer_ensemble( get_initiaux( a1 ), get_initiaux( a2 ) ) == 0
+		&& comparer_ensemble( get_finaux( a1 ), get_finaux( a2 ) ) == 0;
+}
+
+int test_fichier_automate(){
+	int result = 1;
+
+	{
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 3, 'a', 5 );
+		ajouter_transition( automate, 3, 'a', -2 );
+		ajouter_transition( automate, 5, 'b', 3 );
+		ajouter_transition( automate, -2, 'c', -2 );
+		ajouter_etat( automate, 100 );
+		ajouter_lettre( automate, 'z' );
+		ajouter_etat_initial( automate, 3 );
+		ajouter_etat_final( automate, -2 );
+
+		TEST( sauver_automate( automate, FICHIER_TEST ) == 0, result );
+		Automate * charge = charger_automate_mmap( FICHIER_TEST );
+
+		TEST(
+			1
+			&& charge
+			&& automates_identiques( automate, charge )
+			&& est_une_transition_de_l_automate( charge, 3, 'a', 5 )
+			&& est_une_transition_de_l_automate( charge, 3, 'a', -2 )
+			&& est_une_transition_de_l_automate( charge, 5, 'b', 3 )
+			&& est_une_transition_de_l_automate( charge, -2, 'c', -2 )
+			&& ! est_une_transition_de_l_automate( charge, 5, 'a', 3 )
+			&& le_mot_est_reconnu( charge, "abaccc" )
+			, result
+		);
+
+		if( charge ) liberer_automate( charge );
+
+		// Un octet modifié invalide le fichier
+		FILE * fichier = fopen( FICHIER_TEST, "r+b" );
+		fseek( fichier, -3, SEEK_END );
+		int octet = fgetc( fichier );
+		fseek( fichier, -3, SEEK_END );
+		fputc( octet ^ 1, fichier );
+		fclose( fichier );
+		TEST( ! charger_automate_mmap( FICHIER_TEST ), result );
+
+		// Un fichier tronqué aussi
+		fichier = fopen( FICHIER_TEST, "wb" );
+		fputs( "AUTOMATE", fichier );
+		fclose( fichier );
+		TEST( ! charger_automate_mmap( FICHIER_TEST ), result );
+
+		TEST( ! charger_automate_mmap( "fichier_qui_n_existe_pas.bin" ), result );
+
+		liberer_automate( automate );
+	}
+
+	{
+		Automate * automate = creer_automate();
+		TEST( sauver_automate( automate, FICHIER_TEST ) == 0, result );
+		Automate * charge = charger_automate_mmap( FICHIER_TEST );
+		TEST( charge && automates_identiques( automate, charge ), result );
+		if( charge ) liberer_automate( charge );
+		liberer_automate( automate );
+	}
+
+	remove( FICHIER_TEST );
+
+	return result;
+}
+int test_projeter_automate(){
+	int result = 1;
+	int i;
+
+	{
+		// Un automate non déterministe sur des états non consécutifs
+		Automate * automate = creer_automate();
+		for( i=0; i<300; i++ ){
+			ajouter_transition( 
+				automate, 3 * ( rand() % 40 ) - 20, 'a' + rand() % 3, 
+				3 * ( rand() % 40 ) - 20 
+			);
+		}
+		ajouter_etat_initial( automate, -20 );
+		ajouter_etat_initial( automate, 1 );
+		ajouter_etat_final( automate, 7 );
+		ajouter_etat_final( automate, 40 );
+		int sauve = sauver_automate( automate, FICHIER_TEST );
+		TEST( sauve == 0, result );
+
+		Automate_projete * projete = projeter_automate( FICHIER_TEST );
+		TEST( projete != NULL, result );
+		if( projete ){
+			// Les destinations sont celles de l'automate d'origine
+			int conformes = 1;
+			Ensemble_curseur it;
+			for(
+				it = premier_curseur_ensemble( get_etats( automate ) );
+				! curseur_ensemble_est_vide( it );
+				it = curseur_suivant_ensemble( it )
+			){
+				char lettre;
+				for( lettre = 'a'; lettre <= 'd'; lettre++ ){
+					int etat = get_element_curseur( it );
+					int nb;
+					const int * fins = delta_projete( projete, etat, lettre, &nb );
+					const Destinations * attendues = voisins( automate, etat, lettre );
+					conformes = conformes
+						&& nb == taille_destinations( attendues )
+						&& memcmp( 
+							fins, etats_destinations( attendues ), nb * sizeof(int) 
+						) == 0;
+				}
+			}
+			TEST( conformes, result );
+
+			int nb;
+			delta_projete( projete, 1000, 'a', &nb );
+			TEST( nb == 0, result );
+
+			// Les mots reconnus aussi
+			char mot[8];
+			int identiques = 1;
+			for( i=0; i<500; i++ ){
+				int longueur = rand() % 8;
+				int j;
+				for( j=0; j<longueur; j++ ){
+					mot[j] = 'a' + rand() % 3;
+				}
+				mot[longueur] = '\0';
+				identiques = identiques 
+					&& le_mot_est_reconnu_projete( projete, mot ) 
+						== le_mot_est_reconnu( automate, mot );
+			}
+			TEST( identiques, result );
+
+			liberer_automate_projete( projete );
+		}
+
+		// Un fichier corrompu n'est pas projeté
+		FILE * fichier = fopen( FICHIER_TEST, "r+b" );
+		fseek( fichier, -3, SEEK_END );
+		int octet = fgetc( fichier );
+		fseek( fichier, -3, SEEK_END );
+		fputc( octet ^ 1, fichier );
+		fclose( fichier );
+		projete = projeter_automate( FICHIER_TEST );
+		TEST( ! projete, result );
+		if( projete ) liberer_automate_projete( projete );
+
+		liberer_automate( automate );
+	}
+
+	{
+		Automate * automate = creer_automate();
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 0 );
+		int sauve = sauver_automate( automate, FICHIER_TEST );
+		TEST( sauve == 0, result );
+		Automate_projete * projete = projeter_automate( FICHIER_TEST );
+		TEST( projete != NULL, result );
+		if( projete ){
+			int vide = le_mot_est_reconnu_projete( projete, "" );
+			int a = le_mot_est_reconnu_projete( projete, "a" );
+			TEST( vide && ! a, result );
+			liberer_automate_projete( projete );
+		}
+		liberer_automate( automate );
+	}
+
+	Automate_projete * absent = projeter_automate( "fichier_qui_n_existe_pas.bin" );
+	TEST( ! absent, result );
+
+	remove( FICHIER_TEST );
+
+	return result;
+}
+
+int ecrire_fichier_test( const char * contenu ){
+	FILE * fichier = fopen( FICHIER_TEST, "w" );
+	if( ! fichier ) return 0;
+	fputs( contenu, fichier );
+	fclose( fichier );
+	return 1;
+}
+
+int test_charger_automate_texte(){
+	int result = 1;
+
+	{
+		int ecrit = ecrire_fichier_test(
+			"# Un automate qui reconnaît a(ba)*\n"
+			"etats 4\n"
+			"\n"
+			"initial 0\n"
+			"final 1   # commentaire\n"
+			"0 a 1# commentaire\n"
+			"  1\tb   2\r\n"
+			"2 a 1\n"
+			"2 a 1\n"
+			"1 # 2"
+		);
+		TEST( ecrit, result );
+		Automate * automate = charger_automate_texte( FICHIER_TEST );
+
+		TEST(
+			1
+			&& automate
+			&& taille_ensemble( get_etats( automate ) ) == 4
+			&& est_un_etat_de_l_automate( automate, 3 )
+			&& est_un_etat_initial_de_l_automate( automate, 0 )
+			&& est_un_etat_final_de_l_automate( automate, 1 )
+			&& est_une_transition_de_l_automate( automate, 1, '#', 2 )
+			&& taille_ensemble( get_alphabet( automate ) ) == 3
+			&& le_mot_est_reconnu( automate, "a" )
+			&& le_mot_est_reconnu( automate, "ababa" )
+			&& ! le_mot_est_reconnu( automate, "ab" )
+			, result
+		);
+
+		if( automate ) liberer_automate( automate );
+	}
+
+	{
+		// Sans en-tête, les états sont quelconques.
+		int ecrit = ecrire_fichier_test(
+			"-7 # -8\n"
+			"final -8\n"
+			"initial 2147483647\n"
+		);
+		TEST( ecrit, result );
+		Automate * automate = charger_automate_texte( FICHIER_TEST );
+
+		TEST(
+			1
+			&& automate
+			&& taille_ensemble( get_etats( automate ) ) == 3
+			&& est_un_etat_final_de_l_automate( automate, -8 )
+			&& est_un_etat_initial_de_l_automate( automate, 2147483647 )
+			&& est_une_transition_de_l_automate( automate, -7, '#', -8 )
+			, result
+		);
+
+		if( automate ) liberer_automate( automate );
+	}
+
+	{
+		int ecrit = ecrire_fichier_test( "" );
+		TEST( ecrit, result );
+		Automate * automate = charger_automate_texte( FICHIER_TEST );
+		TEST( 
+			automate && taille_ensemble( get_etats( automate ) ) == 0, 
+			result 
+		);
+		if( automate ) liberer_automate( automate );
+	}
+
+	{
+		const char * erreurs[] = {
+			"0 a\n",
+			"0 a 1 2\n",
+			"initial\n",
+			"final x\n",
+			"0 a 1\netats 3\n",
+			"0 a 99999999999\n",
+			"etats -1\n",
+			// Nombres et lettres non séparés
+			"12a3\n",
+			"12 a3\n",
+			"12a 3\n",
+			"0 a 1x\n",
+			"initial 0x\n",
+			"final 1-2\n",
+			"etats 3a\n",
+			// États hors de l'en-tête
+			"etats 2\n0 a 2\n",
+			"etats 2\n-1 a 0\n",
+			"etats 2\ninitial 5\n",
+			"etats 2\nfinal -1\n",
+			"etats 0\ninitial 0\n"
+		};
+		int i;
+		for( i=0; i<(int)( sizeof(erreurs) / sizeof(erreurs[0]) ); i++ ){
+			int ecrit = ecrire_fichier_test( erreurs[i] );
+			TEST( ecrit, result );
+			Automate * automate = charger_automate_texte( FICHIER_TEST );
+			TEST( ! automate, result );
+			if( automate ) liberer_automate( automate );
+		}
+	}
+
+	TEST( ! charger_automate_texte( "fichier_qui_n_existe_pas.txt" ), result );
+
+	remove( FICHIER_TEST );
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_fichier_automate() ){ return 1; };
+	if( ! test_projeter_automate() ){ return 1; };
+	if( ! test_charger_automate_texte() ){ return 1; };
+
+	return 0;
+	
+}
@@ -0,0 +1,142 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "fifo.h"
+#include "outils.h"
+
+int test_ordre_fifo(){
+	int result = 1;
+	int i;
+	intptr_t element;
+
+	Fifo * fifo = creer_fifo();
+	TEST( est_vide( fifo ), result );
+
+	ajouter_fifo( fifo, 1 );
+	ajouter_fifo( fifo, 2 );
+	ajouter_fifo( fifo, 3 );
+	TEST( taille_fifo( fifo ) == 3, result );
+	TEST( obtenir_fifo( fifo ) == 1, result );
+	element = retirer_fifo( fifo );
+	TEST( element == 1, result );
+	element = retirer_fifo( fifo );
+	TEST( element == 2, result );
+	ajouter_fifo( fifo, 4 );
+	element = retirer_fifo( fifo );
+	TEST( element == 3, result );
+	element = retirer_fifo( fifo );
+	TEST( element == 4, result );
+	TEST( est_vide( fifo ), result );
+
+	// Le début de la file fait plusieurs fois le tour du tableau, qui est
+	// agrandi alors que les éléments sont coupés en deux morceaux.
+	int prochain_ajout = 0, prochain_retrait = 0;
+	for( i=0; i<1000; i++ ){
+		ajouter_fifo( fifo, prochain_ajout++ );
+		ajouter_fifo( fifo, prochain_ajout++ );
+		element = retirer_fifo( fifo );
+		TEST( element == prochain_retrait, result );
+		prochain_retrait++;
+	}
+	TEST( taille_fifo( fifo ) == 1000, result );
+	while( ! est_vide( fifo ) ){
+		element = retirer_fifo( fifo );
+		TEST( element == prochain_retrait, result );
+		prochain_retrait++;
+	}
+	TEST( prochain_retrait == 2000, result );
+
+	liberer_fifo( fifo );
+	return result;
+}
+
+int test_ajouter_fifo_en_masse(){
+	int result = 1;
+	int i;
+	intptr_t element;
+
+	intptr_t elements[100];
+	for( i=0; i<100; i++ ){
+		elements[i] = i;
+	}
+
+	Fifo * fifo = creer_fifo();
+	// Le tableau est déjà entamé : l'ajout en masse fait le tour du tableau
+	for( i=0; i<10; i++ ){
+		ajouter_fifo( fifo, -1 );
+	}
+	for( i=0; i<10; i++ ){
+		retirer_fifo( fifo );
+	}
+	ajouter_fifo_en_masse( fifo, elements, 12 );
+	ajouter_fifo_en_masse( fifo, elements, 0 );
+	TEST( taille_fifo( fifo ) == 12, result );
+	for( i=0; i<12; i++ ){
+		element = retirer_fifo( fifo );
+		TEST( element == i, result );
+	}
+
+	ajouter_fifo( fifo, -1 );
+	ajouter_fifo_en_masse( fifo, elements, 100 );
+	TEST( taille_fifo( fifo ) == 101, result );
+	element = retirer_fifo( fifo );
+	TEST( element == -1, result );
+	for( i=0; i<100; i++ ){
+		element = retirer_fifo( fifo );
+		TEST( element == i, result );
+	}
+	TEST( est_vide( fifo ), result );
+
+	liberer_fifo( fifo );
+	return result;
+}
+
+int test_grande_fifo(){
+	int result = 1;
+	int i, n = 1000000;
+
+	Fifo * fifo = creer_fifo();
+	for( i=0; i<n; i++ ){
+		ajouter_fifo( fifo, i );
+	}
+	TEST( taille_fifo( fifo ) == n, result );
+	int dans_l_ordre = 1;
+	for( i=0; i<n/2; i++ ){
+		if( retirer_fifo( fifo ) != i ) dans_l_ordre = 0;
+	}
+	TEST( dans_l_ordre, result );
+	// La file est libérée sans récursion, même si elle est grande
+	liberer_fifo( fifo );
+	return result;
+}
+
+int main(){
+	int result = 1;
+
+	result &= test_ordre_fifo();
+	result &= test_ajouter_fifo_en_masse();
+	result &= test_grande_fifo();
+
+	if( ! result ){ return 1; }
+	return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "automate.h"
+#include "outils.h"
+
+#include <stdio.h>
+
+int test_fusionner_automates(){
+	int result = 1;
+
+	{
+		// La destination est plus petite que la source
+		Automate * automate_1 = mot_to_automate( "a" );
+		Automate * automate_2 = mot_to_automate( "bbbbb" );
+
+		fusionner_automates( automate_1, automate_2 );
+
+		TEST(
+			1
+			&& le_mot_est_reconnu( automate_1, "a" )
+			&& le_mot_est_reconnu( automate_1, "bbbbb" )
+			&& ! le_mot_est_reconnu( automate_1, "" )
+			&& ! le_mot_est_reconnu( automate_1, "ab" )
+			&& ! le_mot_est_reconnu( automate_1, "bbbb" )
+			&& taille_ensemble( get_etats( automate_1 ) ) == 8
+			, result
+		);
+
+		liberer_automate( automate_1 );
+	}
+
+	{
+		// On replie des mots dans un seul automate
+		Automate * dictionnaire = creer_automate();
+		char mot[8];
+		int i;
+		for( i=0; i<200; i++ ){
+			sprintf( mot, "m%d", i );
+			fusionner_automates( dictionnaire, mot_to_automate( mot ) );
+		}
+
+		TEST(
+			1
+			&& le_mot_est_reconnu( dictionnaire, "m0" )
+			&& le_mot_est_reconnu( dictionnaire, "m57" )
+			&& le_mot_est_reconnu( dictionnaire, "m199" )
+			&& ! le_mot_est_reconnu( dictionnaire, "m200" )
+			&& ! le_mot_est_reconnu( dictionnaire, "m" )
+			&& taille_ensemble( get_initiaux( dictionnaire ) ) == 200
+			, result
+		);
+
+		liberer_automate( dictionnaire );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_fusionner_automates() ){ return 1; };
+
+	return 0;
+	
+}
@@ -0,0 +1,175 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "automate.h"
+#include "outils.h"
+
+#include <pthread.h>
+
+#define NB_THREADS 4
+#define NB_ALLOCATIONS_PAR_THREAD 1000
+
+void* allouer_cent_octets(){
+	return xmalloc( 100 );
+}
+
+void* allouer_et_liberer( void* data ){
+	int i;
+	for( i=0; i<NB_ALLOCATIONS_PAR_THREAD; i++ ){
+		xfree( xmalloc( 8 ) );
+	}
+	return NULL;
+}
+
+int test_compteurs_par_site(){
+	int result = 1;
+
+	reinitialiser_instrumentation_allocations();
+	Statistiques_allocations site, total;
+
+	void* bloc = allouer_cent_octets();
+	statistiques_allocations_site( "allouer_cent_octets", &site );
+	TEST( site.nb_allocations == 1, result );
+	TEST( site.octets_alloues == 100, result );
+	TEST( site.octets_vivants == 100, result );
+	TEST( histogramme_allocations( 7 ) == 1, result );
+
+	// La libération est attribuée au site qui a alloué le bloc
+	xfree( bloc );
+	statistiques_allocations_site( "allouer_cent_octets", &site );
+	TEST( site.nb_liberations == 1, result );
+	TEST( site.octets_vivants == 0, result );
+	TEST( site.pic_octets_vivants == 100, result );
+
+	char* texte = xrealloc( NULL, 10 );
+	texte = xrealloc( texte, 1000 );
+	statistiques_allocations_site( "test_compteurs_par_site", &site );
+	TEST( site.nb_allocations == 2, result );
+	TEST( site.nb_liberations == 1, result );
+	TEST( site.octets_vivants == 1000, result );
+	xfree( texte );
+
+	statistiques_allocations( &total );
+	TEST( total.nb_allocations == 3, result );
+	TEST( total.octets_vivants == 0, result );
+	TEST( total.pic_octets_vivants == 1000, result );
+	TEST( ! statistiques_allocations_site( "absent", &site ), result );
+
+	return result;
+}
+
+int test_activation(){
+	int result = 1;
+
+	reinitialiser_instrumentation_allocations();
+	Statistiques_allocations total;
+
+	void* compte = xmalloc( 16 );
+	activer_instrumentation_allocations( 0 );
+	void* non_compte = xmalloc( 16 );
+	// Un bloc alloué pendant l'instrumentation est décompté à sa libération
+	xfree( compte );
+	statistiques_allocations( &total );
+	TEST( total.nb_allocations == 1, result );
+	TEST( total.octets_vivants == 0, result );
+
+	activer_instrumentation_allocations( 1 );
+	xfree( non_compte );
+	statistiques_allocations( &total );
+	TEST( total.nb_liberations == 1, result );
+
+	// Les blocs alloués avant une remise à zéro ne sont plus décomptés
+	void* ancien = xmalloc( 32 );
+	reinitialiser_instrumentation_allocations();
+	xfree( ancien );
+	statistiques_allocations( &total );
+	TEST( total.nb_liberations == 0, result );
+	TEST( total.octets_vivants == 0, result );
+
+	return result;
+}
+
+int test_allocations_de_l_automate(){
+	int result = 1;
+
+	reinitialiser_instrumentation_allocations();
+	Statistiques_allocations site, total;
+
+	Automate * automate = creer_automate();
+	ajouter_transition( automate, 0, 'a', 1 );
+	TEST( statistiques_allocations_site( "creer_automate", &site ), result );
+	TEST( site.nb_allocations > 0, result );
+	TEST( statistiques_allocations_site( "avl_malloc", &site ), result );
+	liberer_automate( automate );
+
+	statistiques_allocations( &total );
+	TEST( total.nb_allocations == total.nb_liberations, result );
+	TEST( total.octets_vivants == 0, result );
+
+	return result;
+}
+
+int test_threads(){
+	int result = 1;
+	int i;
+
+	reinitialiser_instrumentation_allocations();
+	pthread_t threads[NB_THREADS];
+	for( i=0; i<NB_THREADS; i++ ){
+		pthread_create( &threads[i], NULL, allouer_et_liberer, NULL );
+	}
+	for( i=0; i<NB_THREADS; i++ ){
+		pthread_join( threads[i], NULL );
+	}
+	Statistiques_allocations site;
+	statistiques_allocations_site( "allouer_et_liberer", &site );
+	TEST( site.nb_allocations == NB_THREADS * NB_ALLOCATIONS_PAR_THREAD, result );
+	TEST( site.nb_liberations == NB_THREADS * NB_ALLOCATIONS_PAR_THREAD, result );
+	TEST( site.octets_vivants == 0, result );
+
+	return result;
+}
+
+int main(){
+	int result = 1;
+
+	if( ! activer_instrumentation_allocations( 1 ) ){
+		// Sans INSTRUMENTER_ALLOCATIONS, rien n'est compté
+		Statistiques_allocations total;
+		xfree( xmalloc( 10 ) );
+		statistiques_allocations( &total );
+		TEST( total.nb_allocations == 0, result );
+		TEST( histogramme_allocations( 4 ) == 0, result );
+		if( ! result ){ return 1; }
+		return 0;
+	}
+
+	result &= test_compteurs_par_site();
+	result &= test_activation();
+	result &= test_allocations_de_l_automate();
+	result &= test_threads();
+
+	activer_instrumentation_allocations( 0 );
+	if( ! result ){ return 1; }
+	return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "interneur.h"
+#include "outils.h"
+
+Ensemble * creer_ensemble_de( const int * elements, int n ){
+	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
+	int i;
+	for( i=0; i<n; i++ ){
+		ajouter_element( res, elements[i] );
+	}
+	return res;
+}
+
+int test_interneur(){
+	int result = 1;
+
+	{
+		int t1[] = { 3, 1, 2 };
+		int t2[] = { 1, 2, 3 };
+		int t3[] = { 1, 2 };
+		int t4[] = { 4 };
+
+		Ensemble * e1 = creer_ensemble_de( t1, 3 );
+		Ensemble * e2 = creer_ensemble_de( t2, 3 );
+		TEST( hash_ensemble( e1 ) == hash_ensemble( e2 ), result );
+
+		Interneur * interneur = creer_interneur();
+		int nouveau;
+		const Ensemble_interne * i1 = interner_ensemble( interneur, e1, &nouveau );
+		TEST( nouveau && i1->numero == 0, result );
+		const Ensemble_interne * i2 = interner_ensemble( interneur, e2, &nouveau );
+		TEST( ! nouveau && i1 == i2, result );
+		const Ensemble_interne * i3 = interner_ensemble( 
+			interneur, creer_ensemble_de( t3, 2 ), &nouveau 
+		);
+		TEST( nouveau && i3 != i1 && i3->numero == 1, result );
+		const Ensemble_interne * i4 = interner_ensemble( 
+			interneur, creer_ensemble_de( t4, 1 ), NULL
+		);
+		const Ensemble_interne * vide = interner_ensemble( 
+			interneur, creer_ensemble( NULL, NULL, NULL ), NULL
+		);
+
+		Ensemble * e3 = creer_ensemble_de( t3, 2 );
+		Ensemble * e5 = creer_ensemble_de( t4, 1 );
+		ajouter_element( e5, 5 );
+		TEST(
+			1
+			&& nombre_ensembles_internes( interneur ) == 4
+			&& ensemble_interne_numero( interneur, 2 ) == i4
+			&& ensemble_interne_numero( interneur, 3 ) == vide
+			&& vide->hash == 0
+			&& trouver_ensemble_interne( interneur, e3 ) == i3
+			&& trouver_ensemble_interne( interneur, e5 ) == NULL
+			&& taille_ensemble( i1->ensemble ) == 3
+			, result
+		);
+		liberer_ensemble( e3 );
+		liberer_ensemble( e5 );
+		liberer_interneur( interneur );
+	}
+
+	{
+		// Beaucoup d'ensembles : la table de hachage est agrandie
+		Interneur * interneur = creer_interneur();
+		int i, j;
+		for( j=0; j<2; j++ ){
+			for( i=0; i<1000; i++ ){
+				Ensemble * e = creer_ensemble( NULL, NULL, NULL );
+				ajouter_element( e, i % 37 );
+				ajouter_element( e, i );
+				const Ensemble_interne * interne = interner_ensemble( interneur, e, NULL );
+				TEST( interne->numero == i, result );
+			}
+		}
+		TEST( nombre_ensembles_internes( interneur ) == 1000, result );
+		liberer_interneur( interneur );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_interneur() ){ return 1; };
+
+	return 0;
+	
+}
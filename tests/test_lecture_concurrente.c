@@ -0,0 +1,179 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate.h"
+#include "expression.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#define NB_THREADS 8
+#define NB_MOTS 64
+#define NB_TOURS 200
+
+/*
+ * Plusieurs threads lisent le même automate, et comparent ce qu'ils lisent à
+ * ce qui a été calculé avant leur lancement.
+ */
+typedef struct {
+	const Automate * automate;
+	char mots[NB_MOTS][16];
+	int reconnus[NB_MOTS];
+	int tailles_delta_star[NB_MOTS];
+	int nb_transitions;
+	int max_etat;
+} Donnees_partagees;
+
+typedef struct {
+	Donnees_partagees * partage;
+	int numero;
+	int erreurs;
+} Lecteur;
+
+void action_compter_transitions_lues( int origine, char lettre, int fin, void* data ){
+	(*(int*) data) += 1;
+}
+
+int compter_transitions( const Automate * automate ){
+	int n = 0;
+	pour_toute_transition( automate, action_compter_transitions_lues, &n );
+	return n;
+}
+
+void * lire_automate( void * data ){
+	Lecteur * lecteur = (Lecteur *) data;
+	Donnees_partagees * partage = lecteur->partage;
+	const Automate * automate = partage->automate;
+	int tour, i;
+	for( tour = 0; tour < NB_TOURS; tour++ ){
+		i = ( tour * 7 + lecteur->numero ) % NB_MOTS;
+		const char * mot = partage->mots[i];
+		if( le_mot_est_reconnu( automate, mot ) != partage->reconnus[i] ){
+			lecteur->erreurs++;
+		}
+		Ensemble * arrivee = delta_star( automate, get_initiaux( automate ), mot );
+		if( taille_ensemble( arrivee ) != partage->tailles_delta_star[i] ){
+			lecteur->erreurs++;
+		}
+		liberer_ensemble( arrivee );
+		Ensemble * suivants = delta( automate, get_etats( automate ), mot[0] );
+		Ensemble_iterateur it;
+		for(
+			it = premier_iterateur_ensemble( suivants );
+			! iterateur_ensemble_est_vide( it );
+			it = iterateur_suivant_ensemble( it )
+		){
+			if( ! est_un_etat_de_l_automate( automate, get_element( it ) ) ){
+				lecteur->erreurs++;
+			}
+		}
+		liberer_ensemble( suivants );
+		if( 
+			! est_un_etat_initial_de_l_automate( automate, 0 )
+			|| ! est_une_lettre_de_l_automate( automate, 'a' )
+			|| est_une_lettre_de_l_automate( automate, 'z' )
+			|| get_max_etat( automate ) != partage->max_etat
+		){
+			lecteur->erreurs++;
+		}
+		if( tour % 20 == 0 ){
+			if( compter_transitions( automate ) != partage->nb_transitions ){
+				lecteur->erreurs++;
+			}
+			// Une copie privée, modifiée pendant que les autres lisent
+			Automate * copie = copier_automate( automate );
+			ajouter_transition( copie, 0, 'z', 1000 + lecteur->numero );
+			if( 
+				! le_mot_est_reconnu( copie, mot ) != ! partage->reconnus[i]
+				|| compter_transitions( copie ) != partage->nb_transitions + 1
+			){
+				lecteur->erreurs++;
+			}
+			liberer_automate( copie );
+		}
+	}
+	return NULL;
+}
+
+int test_lecture_concurrente(){
+	int result = 1;
+
+	Automate * automate = regex_to_automate( "(a|b)*a(a|b)(a|b)(c|a)*|b+c?" );
+	Donnees_partagees partage;
+	partage.automate = automate;
+	unsigned int graine = 12345;
+	int i, j;
+	for( i=0; i<NB_MOTS; i++ ){
+		int longueur = 1 + i % 15;
+		for( j=0; j<longueur; j++ ){
+			graine = graine * 1103515245 + 12345;
+			partage.mots[i][j] = 'a' + ( graine >> 16 ) % 3;
+		}
+		partage.mots[i][longueur] = '\0';
+		partage.reconnus[i] = le_mot_est_reconnu( automate, partage.mots[i] );
+		Ensemble * arrivee = delta_star( 
+			automate, get_initiaux( automate ), partage.mots[i] 
+		);
+		partage.tailles_delta_star[i] = taille_ensemble( arrivee );
+		liberer_ensemble( arrivee );
+	}
+	partage.nb_transitions = compter_transitions( automate );
+	partage.max_etat = get_max_etat( automate );
+
+	Lecteur lecteurs[NB_THREADS];
+	pthread_t threads[NB_THREADS];
+	for( i=0; i<NB_THREADS; i++ ){
+		lecteurs[i].partage = &partage;
+		lecteurs[i].numero = i;
+		lecteurs[i].erreurs = 0;
+		if( pthread_create( &threads[i], NULL, lire_automate, &lecteurs[i] ) ){
+			ERREUR( "Impossible de créer un thread" );
+		}
+	}
+	for( i=0; i<NB_THREADS; i++ ){
+		pthread_join( threads[i], NULL );
+		TEST( lecteurs[i].erreurs == 0, result );
+	}
+
+	// L'automate partagé n'a pas été modifié
+	TEST(
+		1
+		&& compter_transitions( automate ) == partage.nb_transitions
+		&& ! est_une_lettre_de_l_automate( automate, 'z' )
+		, result
+	);
+
+	liberer_automate( automate );
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_lecture_concurrente() ){ return 1; };
+
+	return 0;
+	
+}
@@ -0,0 +1,175 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "automate.h"
+#include "avl.h"
+#include "outils.h"
+
+int memoires_egales( Memoire m1, Memoire m2 ){
+	return m1.octets == m2.octets && m1.allocations == m2.allocations;
+}
+
+int test_table_memoire(){
+	int result = 1;
+	int i;
+
+	Table * table = creer_table( NULL, NULL, NULL );
+	Table_memoire_stats stats;
+	table_memoire( table, &stats );
+	TEST( stats.table.allocations == 1, result );
+	TEST( stats.arbre.allocations == 2, result );
+	TEST( stats.noeuds.allocations == 0, result );
+	TEST( stats.total.allocations == 3, result );
+	TEST( stats.nb_partages == 1, result );
+	size_t vide = stats.total.octets;
+
+	for( i=0; i<10; i++ ){
+		add_table( table, i, i );
+	}
+	table_memoire( table, &stats );
+	TEST( stats.noeuds.allocations == 10, result );
+	TEST( stats.noeuds.octets == 10 * sizeof(struct avl_node), result );
+	TEST( stats.total.octets == vide + stats.noeuds.octets, result );
+
+	Table * copie = copier_table( table );
+	table_memoire( copie, &stats );
+	TEST( stats.nb_partages == 2, result );
+	TEST( stats.noeuds.allocations == 10, result );
+
+	liberer_table( copie );
+	liberer_table( table );
+	return result;
+}
+
+int test_ensemble_memoire(){
+	int result = 1;
+
+	Ensemble * ens = creer_ensemble( NULL, NULL, NULL );
+	ajouter_element( ens, 1 );
+	ajouter_element( ens, 2 );
+	Ensemble_memoire_stats stats;
+	ensemble_memoire( ens, &stats );
+	TEST( stats.ensemble.allocations == 1, result );
+	TEST( stats.table.noeuds.allocations == 2, result );
+	TEST( stats.total.allocations == 1 + stats.table.total.allocations, result );
+	TEST( 
+		stats.total.octets == stats.ensemble.octets + stats.table.total.octets,
+		result
+	);
+
+	liberer_ensemble( ens );
+	return result;
+}
+
+int test_automate_memoire(){
+	int result = 1;
+	int i;
+
+	Automate * automate = creer_automate();
+	Automate_memoire_stats vide;
+	automate_memoire( automate, &vide );
+	TEST( vide.destinations.allocations == 0, result );
+	TEST( vide.noeuds_avl.allocations == 0, result );
+
+	// Deux destinations tiennent dans la structure, une troisième non
+	ajouter_transition( automate, 0, 'a', 1 );
+	ajouter_transition( automate, 0, 'a', 2 );
+	ajouter_transition( automate, 1, 'b', 2 );
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, 2 );
+	Automate_memoire_stats stats;
+	automate_memoire( automate, &stats );
+	// Les Destinations sont rangées dans les noeuds des clés
+	TEST( stats.destinations.allocations == 0, result );
+	TEST( stats.etats.allocations == vide.etats.allocations + 3, result );
+	TEST( stats.alphabet.allocations == vide.alphabet.allocations + 2, result );
+	TEST( stats.initiaux.allocations == vide.initiaux.allocations + 1, result );
+	TEST( stats.finaux.allocations == vide.finaux.allocations + 1, result );
+	TEST( 
+		stats.cles_transitions.allocations == 
+			vide.cles_transitions.allocations + 2, 
+		result 
+	);
+	TEST( stats.noeuds_avl.allocations == 3 + 2 + 1 + 1 + 2, result );
+	Table_memoire_stats table;
+	table_memoire( automate->transitions, &table );
+	TEST( 
+		table.noeuds.octets == 
+			2 * ( sizeof(struct avl_node) + sizeof(Destinations) ), 
+		result 
+	);
+
+	ajouter_transition( automate, 0, 'a', 3 );
+	automate_memoire( automate, &stats );
+	TEST( stats.destinations.allocations == 1, result );
+	TEST( 
+		stats.destinations.octets == 
+			2 * NB_DESTINATIONS_EN_LIGNE * sizeof(int), 
+		result 
+	);
+
+	Memoire total = { 0, 0 };
+	ajouter_memoire( &total, stats.automate );
+	ajouter_memoire( &total, stats.etats );
+	ajouter_memoire( &total, stats.alphabet );
+	ajouter_memoire( &total, stats.initiaux );
+	ajouter_memoire( &total, stats.finaux );
+	ajouter_memoire( &total, stats.cles_transitions );
+	ajouter_memoire( &total, stats.destinations );
+	TEST( memoires_egales( total, stats.total ), result );
+
+	// Une copie partage ses arbres, mais est comptée en entier
+	Automate * copie = copier_automate( automate );
+	Automate_memoire_stats stats_copie;
+	automate_memoire( copie, &stats_copie );
+	TEST( memoires_egales( stats.total, stats_copie.total ), result );
+
+	Automate * gros = creer_automate();
+	for( i=0; i<100; i++ ){
+		ajouter_transition( gros, i, 'a', i+1 );
+	}
+	automate_memoire( gros, &stats );
+	TEST( stats.destinations.allocations == 0, result );
+	TEST( 
+		stats.cles_transitions.allocations == 
+			vide.cles_transitions.allocations + 100, 
+		result 
+	);
+	TEST( stats.total.octets > vide.total.octets, result );
+
+	liberer_automate( gros );
+	liberer_automate( copie );
+	liberer_automate( automate );
+	return result;
+}
+
+int main(){
+	int result = 1;
+
+	result &= test_table_memoire();
+	result &= test_ensemble_memoire();
+	result &= test_automate_memoire();
+
+	if( ! result ){ return 1; }
+	return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "automate.h"
+#include "parcours_parallele.h"
+#include "outils.h"
+
+int test_parcours_parallele(){
+	int result = 1;
+
+	{
+		// Une longue chaîne : beaucoup de niveaux avec une petite frontière
+		Automate * automate = creer_automate();
+		int i;
+		for( i=0; i<2000; i++ ){
+			ajouter_transition( automate, 3*i, 'a', 3*(i+1) );
+		}
+		ajouter_transition( automate, -5, 'a', 0 );
+		ajouter_etat_initial( automate, 30 );
+		ajouter_etat_final( automate, 300 );
+
+		int nb_threads;
+		for( nb_threads = 1; nb_threads <= 4; nb_threads++ ){
+			Ensemble * acc = accessibles_parallele( automate, nb_threads );
+			Ensemble * co_acc = co_accessibles_parallele( automate, nb_threads );
+			TEST(
+				1
+				&& taille_ensemble( acc ) == 1991
+				&& est_dans_l_ensemble( acc, 30 )
+				&& est_dans_l_ensemble( acc, 6000 )
+				&& ! est_dans_l_ensemble( acc, 27 )
+				&& taille_ensemble( co_acc ) == 102
+				&& est_dans_l_ensemble( co_acc, -5 )
+				&& est_dans_l_ensemble( co_acc, 300 )
+				&& ! est_dans_l_ensemble( co_acc, 303 )
+				, result
+			);
+			liberer_ensemble( acc );
+			liberer_ensemble( co_acc );
+		}
+
+		liberer_automate( automate );
+	}
+
+	{
+		// Des automates aléatoires denses : la frontière devient grande
+		int essai;
+		for( essai = 0; essai < 10; essai++ ){
+			Automate * automate = creer_automate();
+			int i;
+			for( i=0; i<3000; i++ ){
+				ajouter_transition( 
+					automate, rand() % 1000, 'a' + rand() % 2, rand() % 1000 
+				);
+			}
+			for( i=0; i<200; i++ ){
+				ajouter_etat( automate, 1000 + i );
+			}
+			ajouter_etat_initial( automate, rand() % 1000 );
+			ajouter_etat_final( automate, rand() % 1000 );
+
+			Ensemble * attendu = accessibles( automate );
+			Ensemble * acc = accessibles_parallele( automate, 1 + essai % 4 );
+			Automate * mir = miroir( automate );
+			Ensemble * co_attendu = accessibles( mir );
+			Ensemble * co_acc = co_accessibles_parallele( automate, 1 + essai % 4 );
+			TEST(
+				1
+				&& comparer_ensemble( attendu, acc ) == 0
+				&& comparer_ensemble( co_attendu, co_acc ) == 0
+				, result
+			);
+			liberer_ensemble( attendu );
+			liberer_ensemble( acc );
+			liberer_ensemble( co_attendu );
+			liberer_ensemble( co_acc );
+			liberer_automate( mir );
+			liberer_automate( automate );
+		}
+	}
+
+	{
+		// Assez de transitions pour numéroter les états d'arrivée avec 
+		// plusieurs threads, sur des états non consécutifs
+		int n = 200000;
+		int * origines = xmalloc( n * sizeof(int) );
+		int * fins = xmalloc( n * sizeof(int) );
+		char * lettres = xmalloc( n );
+		int i;
+		for( i=0; i<n; i++ ){
+			origines[i] = 7 * ( rand() % 60000 ) - 1000;
+			fins[i] = 7 * ( rand() % 60000 ) - 1000;
+			lettres[i] = 'a' + rand() % 3;
+		}
+		Automate * automate = creer_automate();
+		ajouter_transitions_en_masse( automate, origines, lettres, fins, n );
+		ajouter_etat_initial( automate, origines[0] );
+		ajouter_etat_final( automate, fins[0] );
+
+		Ensemble * attendu = accessibles( automate );
+		Ensemble * acc = accessibles_parallele( automate, 4 );
+		Automate * mir = miroir( automate );
+		Ensemble * co_attendu = accessibles( mir );
+		Ensemble * co_acc = co_accessibles_parallele( automate, 3 );
+		TEST(
+			1
+			&& comparer_ensemble( attendu, acc ) == 0
+			&& comparer_ensemble( co_attendu, co_acc ) == 0
+			, result
+		);
+		liberer_ensemble( attendu );
+		liberer_ensemble( acc );
+		liberer_ensemble( co_attendu );
+		liberer_ensemble( co_acc );
+		liberer_automate( mir );
+		liberer_automate( automate );
+		xfree( lettres );
+		xfree( fins );
+		xfree( origines );
+	}
+
+	{
+		Automate * automate = creer_automate();
+		Ensemble * acc = accessibles_parallele( automate, 0 );
+		TEST( taille_ensemble( acc ) == 0, result );
+		liberer_ensemble( acc );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_parcours_parallele() ){ return 1; };
+
+	return 0;
+	
+}
@@ -0,0 +1,195 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "specialisation.h"
+#include "outils.h"
+
+DECLARER_ENSEMBLE( int, entiers )
+DECLARER_ENSEMBLE( char, caracteres )
+
+/*
+ * Une clé composée, rangée dans un entier en respectant l'ordre 
+ * lexicographique.
+ */
+typedef struct {
+	short x;
+	short y;
+} Point;
+
+intptr_t point_vers_entier( Point p ){
+	return (intptr_t) p.x * 65536 + ( p.y + 32768 );
+}
+
+Point entier_vers_point( intptr_t cle ){
+	Point p;
+	p.y = (short) ( ( cle & 0xFFFF ) - 32768 );
+	p.x = (short) ( ( cle - ( cle & 0xFFFF ) ) / 65536 );
+	return p;
+}
+
+DECLARER_TABLE( Point, const char *, noms, point_vers_entier, entier_vers_point )
+DECLARER_TABLE( int, int, carres, SANS_CONVERSION, SANS_CONVERSION )
+
+int test_declarer_ensemble(){
+	int result = 1;
+	int i;
+
+	Ensemble * ens = creer_ensemble( NULL, NULL, NULL );
+	for( i=-50; i<50; i+=2 ){
+		entiers_ajouter( ens, i );
+	}
+	entiers_retirer( ens, 0 );
+	TEST( taille_ensemble( ens ) == 49, result );
+	TEST( entiers_contient( ens, -50 ), result );
+	TEST( entiers_contient( ens, 48 ), result );
+	TEST( ! entiers_contient( ens, 0 ), result );
+	TEST( ! entiers_contient( ens, 1 ), result );
+	TEST( entiers_element( premier_curseur_ensemble( ens ) ) == -50, result );
+
+	Ensemble * lettres = creer_ensemble( NULL, NULL, NULL );
+	caracteres_ajouter( lettres, 'b' );
+	caracteres_ajouter( lettres, (char) 200 );
+	TEST( caracteres_contient( lettres, 'b' ), result );
+	TEST( caracteres_contient( lettres, (char) 200 ), result );
+	TEST( ! caracteres_contient( lettres, 'a' ), result );
+	TEST( 
+		caracteres_element( dernier_curseur_ensemble( lettres ) ) == 'b',
+		result
+	);
+
+	liberer_ensemble( lettres );
+	liberer_ensemble( ens );
+	return result;
+}
+
+int test_declarer_table(){
+	int result = 1;
+	int i;
+
+	Table * table = creer_table( NULL, NULL, NULL );
+	Point p1 = { 1, -2 }, p2 = { 1, 3 }, p3 = { -1, 7 }, absent = { 7, 1 };
+	noms_ajouter( table, p1, "p1" );
+	noms_ajouter( table, p2, "p2" );
+	noms_ajouter( table, p3, "p3" );
+	TEST( noms_contient( table, p1 ), result );
+	TEST( ! noms_contient( table, absent ), result );
+	TEST( noms_trouver( table, p2, NULL )[1] == '2', result );
+	TEST( noms_trouver( table, absent, NULL ) == NULL, result );
+
+	// Les clés sont parcourues dans l'ordre lexicographique
+	Table_curseur c = premier_curseur_table( table );
+	TEST( noms_cle( c ).x == -1 && noms_cle( c ).y == 7, result );
+	c = curseur_suivant_table( c );
+	TEST( noms_cle( c ).x == 1 && noms_cle( c ).y == -2, result );
+	TEST( noms_valeur( c )[1] == '1', result );
+	c = curseur_suivant_table( c );
+	TEST( noms_cle( c ).y == 3, result );
+	liberer_table( table );
+
+	Table * carres = creer_table( NULL, NULL, NULL );
+	for( i=0; i<100; i++ ){
+		carres_ajouter( carres, i, i*i );
+	}
+	for( i=0; i<100; i++ ){
+		TEST( carres_trouver( carres, i, -1 ) == i*i, result );
+	}
+	TEST( carres_trouver( carres, 100, -1 ) == -1, result );
+	liberer_table( carres );
+
+	return result;
+}
+
+/*
+ * Renvoie la hauteur du sous-arbre, ou -1 si un facteur d'équilibre, un 
+ * pointeur vers le parent ou l'ordre des clés est incorrect.
+ */
+int hauteur_verifiee( const struct avl_node * n, const struct avl_node * parent ){
+	if( ! n ) return 0;
+	if( n->avl_parent != parent ) return -1;
+	int i;
+	for( i=0; i<2; i++ ){
+		const struct avl_node * fils = n->avl_link[i];
+		if( 
+			fils 
+			&& ( (intptr_t) fils->avl_data < (intptr_t) n->avl_data ) != ( i == 0 )
+		){
+			return -1;
+		}
+	}
+	int g = hauteur_verifiee( n->avl_link[0], n );
+	int d = hauteur_verifiee( n->avl_link[1], n );
+	if( g < 0 || d < 0 || n->avl_balance != d - g ) return -1;
+	return 1 + ( g > d ? g : d );
+}
+
+int test_insertion_en_ligne(){
+	int result = 1;
+	int i;
+
+	Ensemble * ens = creer_ensemble( NULL, NULL, NULL );
+	Ensemble * reference = creer_ensemble( NULL, NULL, NULL );
+	for( i=0; i<1000; i++ ){
+		int element = ( i * 7919 ) % 1013 - 500;
+		entiers_ajouter( ens, element );
+		entiers_ajouter( ens, element );
+		ajouter_element( reference, element );
+	}
+	int hauteur = hauteur_verifiee( ens->table->root->avl_root, NULL );
+	TEST( hauteur > 0 && hauteur <= 15, result );
+	TEST( taille_ensemble( ens ) == 1000, result );
+	TEST( comparer_ensemble( ens, reference ) == 0, result );
+	TEST( hash_ensemble( ens ) == hash_ensemble( reference ), result );
+
+	// L'ajout dans une copie ne modifie pas l'ensemble d'origine
+	Ensemble * copie = copier_ensemble( ens );
+	entiers_ajouter( copie, 10000 );
+	TEST( ! entiers_contient( ens, 10000 ), result );
+	TEST( entiers_contient( copie, 10000 ), result );
+	TEST( taille_ensemble( ens ) == 1000, result );
+
+	Table * table = creer_table( NULL, NULL, NULL );
+	for( i=1000; i>0; i-- ){
+		carres_ajouter( table, i, i );
+		carres_ajouter( table, i, i*i );
+	}
+	hauteur = hauteur_verifiee( table->root->avl_root, NULL );
+	TEST( hauteur > 0 && hauteur <= 15, result );
+	TEST( taille_table( table ) == 1000, result );
+	TEST( carres_trouver( table, 30, -1 ) == 900, result );
+
+	liberer_table( table );
+	liberer_ensemble( copie );
+	liberer_ensemble( reference );
+	liberer_ensemble( ens );
+	return result;
+}
+
+int main(){
+	int result = 1;
+
+	result &= test_declarer_ensemble();
+	result &= test_declarer_table();
+	result &= test_insertion_en_ligne();
+
+	if( ! result ){ return 1; }
+	return 0;
+}
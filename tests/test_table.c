@@ -211,6 +211,56 @@ int test_add_table(){
 	return 1;
 }
 
+int test_add_table_triee(){
+	int result = 1;
+	int i;
+
+	intptr_t cles[1000];
+	intptr_t valeurs[1000];
+	for( i=0; i<1000; i++ ){
+		cles[i] = 2*i - 500;
+		valeurs[i] = i;
+	}
+
+	Table * table = creer_table( NULL, NULL, NULL );
+	add_table_triee( table, cles, valeurs, 1000 );
+
+	TEST( taille_table( table ) == 1000, result );
+	for( i=0; i<1000; i++ ){
+		TEST( get_valeur( trouver_table( table, 2*i - 500 ) ) == i, result );
+		TEST( iterateur_est_vide( trouver_table( table, 2*i - 499 ) ), result );
+	}
+
+	// L'arbre construit doit rester équilibré après des ajouts et des 
+	// suppressions
+	for( i=0; i<1000; i++ ){
+		add_table( table, 2*i - 499, -i );
+	}
+	for( i=0; i<1000; i+=2 ){
+		delete_table( table, 2*i - 500 );
+	}
+	TEST( taille_table( table ) == 1500, result );
+	Table_iterateur it = premier_iterateur_table( table );
+	intptr_t precedente = get_cle( it );
+	for(
+		it = iterateur_suivant_table( it );
+		! iterateur_est_vide( it );
+		it = iterateur_suivant_table( it )
+	){
+		TEST( precedente < get_cle( it ), result );
+		precedente = get_cle( it );
+	}
+
+	// Une table non vide est complétée association par association
+	add_table_triee( table, cles, NULL, 10 );
+	TEST( taille_table( table ) == 1505, result );
+	TEST( get_valeur( trouver_table( table, -500 ) ) == 0, result );
+
+	liberer_table( table );
+
+	return result;
+}
+
 int test_delete_table(){
 	// Voir general_test
 	return 1;
@@ -406,6 +456,183 @@ int test_get_valeur(){
 }
 
 
+/*
+ * Vérifie que les curseurs parcourent la table dans le même ordre que les 
+ * itérateurs, dans les deux sens.
+ */
+int curseur_conforme( const Table * table ){
+	int result = 1;
+	int n = 0;
+	Table_iterateur it = premier_iterateur_table( table );
+	Table_curseur c = premier_curseur_table( table );
+	while( ! iterateur_est_vide( it ) && ! curseur_est_vide( c ) ){
+		TEST( get_cle( it ) == get_cle_curseur( c ), result );
+		TEST( get_valeur( it ) == get_valeur_curseur( c ), result );
+		it = iterateur_suivant_table( it );
+		c = curseur_suivant_table( c );
+		n++;
+	}
+	TEST( iterateur_est_vide( it ) && curseur_est_vide( c ), result );
+	TEST( n == taille_table( (Table*) table ), result );
+
+	it = dernier_iterateur_table( table );
+	c = dernier_curseur_table( table );
+	while( ! iterateur_est_vide( it ) && ! curseur_est_vide( c ) ){
+		TEST( get_cle( it ) == get_cle_curseur( c ), result );
+		it = iterateur_precedent_table( it );
+		c = curseur_precedent_table( c );
+	}
+	TEST( iterateur_est_vide( it ) && curseur_est_vide( c ), result );
+	return result;
+}
+
+int test_curseur_table(){
+	int result = 1;
+	int i;
+
+	Table * table = creer_table( NULL, NULL, NULL );
+	TEST( curseur_est_vide( premier_curseur_table( table ) ), result );
+	TEST( curseur_est_vide( dernier_curseur_table( table ) ), result );
+
+	// Les ajouts et suppressions déclenchent toutes les rotations
+	for( i=0; i<1000; i++ ){
+		add_table( table, ( i * 7919 ) % 1000, i );
+	}
+	TEST( curseur_conforme( table ), result );
+	for( i=0; i<1000; i+=3 ){
+		delete_table( table, ( i * 104729 ) % 1000 );
+	}
+	TEST( curseur_conforme( table ), result );
+
+	// Arbres copiés et construits en masse
+	Table * clone = cloner_table( table, NULL );
+	delete_table( clone, 1 );
+	TEST( curseur_conforme( clone ), result );
+	TEST( curseur_conforme( table ), result );
+	liberer_table( clone );
+
+	intptr_t cles[100];
+	for( i=0; i<100; i++ ){
+		cles[i] = i;
+	}
+	Table * triee = creer_table( NULL, NULL, NULL );
+	add_table_triee( triee, cles, cles, 100 );
+	TEST( curseur_conforme( triee ), result );
+	for( i=0; i<100; i+=2 ){
+		delete_table( triee, i );
+	}
+	TEST( curseur_conforme( triee ), result );
+	liberer_table( triee );
+
+	while( taille_table( table ) != 0 ){
+		delete_table( table, get_cle_curseur( premier_curseur_table( table ) ) );
+	}
+	TEST( curseur_est_vide( premier_curseur_table( table ) ), result );
+	liberer_table( table );
+
+	return result;
+}
+
+int test_cle_nulle(){
+	int result = 1;
+
+	// La clé 0 et la valeur 0 sont des associations comme les autres
+	Table * table = creer_table( NULL, NULL, NULL );
+	add_table( table, 0, 0 );
+	add_table( table, -1, 3 );
+	add_table( table, 1, 0 );
+	TEST( taille_table( table ) == 3, result );
+	TEST( ! iterateur_est_vide( trouver_table( table, 0 ) ), result );
+	TEST( get_cle( trouver_table( table, 0 ) ) == 0, result );
+	TEST( get_cle_curseur( premier_curseur_table( table ) ) == -1, result );
+
+	add_table( table, 0, 7 );
+	TEST( taille_table( table ) == 3, result );
+	TEST( get_valeur( trouver_table( table, 0 ) ) == 7, result );
+
+	Table * copie = copier_table( table );
+	TEST( delete_table( copie, 0 ) == 7, result );
+	TEST( iterateur_est_vide( trouver_table( copie, 0 ) ), result );
+	TEST( get_valeur( trouver_table( table, 0 ) ) == 7, result );
+	TEST( delete_table( copie, 0 ) == 0, result );
+	TEST( taille_table( copie ) == 2, result );
+
+	liberer_table( copie );
+	liberer_table( table );
+	return result;
+}
+
+typedef struct {
+	int x;
+	int y;
+	double z;
+} Triplet;
+
+const Triplet * triplet( Table * table, intptr_t cle ){
+	return (const Triplet *) get_valeur( trouver_table( table, cle ) );
+}
+
+int test_valeurs_en_ligne(){
+	int result = 1;
+
+	Table * table = creer_table_valeurs_en_ligne( 
+		NULL, NULL, NULL, sizeof(Triplet) 
+	);
+	Triplet t = { 1, 2, 3.5 };
+	add_table( table, 10, (intptr_t) &t );
+	t.x = 4;
+	add_table( table, 20, (intptr_t) &t );
+	add_table( table, 30, 0 );
+
+	// Les valeurs sont recopiées dans les noeuds
+	t.x = 100;
+	TEST( triplet( table, 10 )->x == 1, result );
+	TEST( triplet( table, 10 )->z == 3.5, result );
+	TEST( triplet( table, 20 )->x == 4, result );
+	TEST( triplet( table, 30 )->x == 0 && triplet( table, 30 )->z == 0, result );
+	TEST( 
+		get_valeur_curseur( premier_curseur_table( table ) ) == 
+			(intptr_t) triplet( table, 10 ),
+		result 
+	);
+
+	// La valeur se modifie sur place
+	( (Triplet *) get_valeur( trouver_table( table, 30 ) ) )->y = 7;
+	TEST( triplet( table, 30 )->y == 7, result );
+
+	// Les copies ont leurs propres valeurs dès qu'elles sont modifiées
+	Table * copie = copier_table( table );
+	add_table( copie, 10, (intptr_t) &t );
+	TEST( triplet( copie, 10 )->x == 100, result );
+	TEST( triplet( table, 10 )->x == 1, result );
+	Table * clone = cloner_table( table, NULL );
+	TEST( triplet( clone, 20 )->x == 4, result );
+	TEST( triplet( clone, 20 ) != triplet( table, 20 ), result );
+
+	TEST( delete_table( clone, 20 ) == 0, result );
+	TEST( taille_table( clone ) == 2, result );
+
+	// Construction triée
+	Table * triee = creer_table_valeurs_en_ligne( 
+		NULL, NULL, NULL, sizeof(Triplet) 
+	);
+	Triplet valeurs[3] = { { 1, 0, 0 }, { 2, 0, 0 }, { 3, 0, 0 } };
+	intptr_t cles[3] = { -5, 0, 5 };
+	intptr_t pointeurs[3] = { 
+		(intptr_t) &valeurs[0], 0, (intptr_t) &valeurs[2] 
+	};
+	add_table_triee( triee, cles, pointeurs, 3 );
+	TEST( triplet( triee, -5 )->x == 1, result );
+	TEST( triplet( triee, 0 )->x == 0, result );
+	TEST( triplet( triee, 5 )->x == 3, result );
+
+	liberer_table( triee );
+	liberer_table( clone );
+	liberer_table( copie );
+	liberer_table( table );
+	return result;
+}
+
 int main(){
 
 	int result = 1;
@@ -414,6 +641,7 @@ int main(){
 	result &= test_creer_table();
 	result &= test_liberer_table();
 	result &= test_add_table();
+	result &= test_add_table_triee();
 	result &= test_delete_table();
 	result &= test_vider_table();
 //	result &= test_print_table();
@@ -422,6 +650,9 @@ int main(){
 	result &= test_trouver_table();
 	result &= test_get_cle();
 	result &= test_get_valeur();
+	result &= test_curseur_table();
+	result &= test_cle_nulle();
+	result &= test_valeurs_en_ligne();
 
 	if( ! result ){
 		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
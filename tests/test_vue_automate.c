@@ -0,0 +1,179 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "automate.h"
+#include "outils.h"
+
+/*
+ * Compte les transitions, et celles qui manquent dans un autre automate.
+ */
+typedef struct {
+	const Automate * autre;
+	int nb;
+	int manquantes;
+} Comparaison_transitions;
+
+void comparer_transition( int origine, char lettre, int fin, void* data ){
+	Comparaison_transitions * comparaison = (Comparaison_transitions*) data;
+	comparaison->nb++;
+	if( 
+		! est_une_transition_de_l_automate( 
+			comparaison->autre, origine, lettre, fin 
+		) 
+	){
+		comparaison->manquantes++;
+	}
+}
+
+void ajouter_transition_lue( int origine, char lettre, int fin, void* data ){
+	ajouter_transition( (Automate*) data, origine, lettre, fin );
+}
+
+void ajouter_voisin( int etat, void* data ){
+	ajouter_element( (Ensemble*) data, etat );
+}
+
+/*
+ * Renvoie 1 si la vue a exactement les états, les états initiaux et finaux 
+ * et les transitions de l'automate 'attendu'.
+ */
+int vue_conforme( const Vue_automate * vue, const Automate * attendu ){
+
+	Ensemble * etats = creer_ensemble( NULL, NULL, NULL );
+	Ensemble * initiaux = creer_ensemble( NULL, NULL, NULL );
+	Ensemble * finaux = creer_ensemble( NULL, NULL, NULL );
+	pour_tout_etat_vue( vue, ajouter_voisin, etats );
+	pour_tout_etat_initial_vue( vue, ajouter_voisin, initiaux );
+	pour_tout_etat_final_vue( vue, ajouter_voisin, finaux );
+	int conforme = 
+		comparer_ensemble( etats, get_etats( attendu ) ) == 0
+		&& comparer_ensemble( initiaux, get_initiaux( attendu ) ) == 0
+		&& comparer_ensemble( finaux, get_finaux( attendu ) ) == 0;
+	liberer_ensemble( etats );
+	liberer_ensemble( initiaux );
+	liberer_ensemble( finaux );
+
+	// Les transitions de la vue sont dans l'automate attendu ...
+	Comparaison_transitions vue_dans_attendu = { attendu, 0, 0 };
+	pour_toute_transition_vue( vue, comparer_transition, &vue_dans_attendu );
+	conforme = conforme && vue_dans_attendu.manquantes == 0;
+
+	// ... et réciproquement.
+	Automate * lues = creer_automate();
+	pour_toute_transition_vue( vue, ajouter_transition_lue, lues );
+	Comparaison_transitions attendu_dans_vue = { lues, 0, 0 };
+	pour_toute_transition( attendu, comparer_transition, &attendu_dans_vue );
+	conforme = 
+		conforme 
+		&& attendu_dans_vue.manquantes == 0
+		&& attendu_dans_vue.nb == vue_dans_attendu.nb;
+	liberer_automate( lues );
+
+	return conforme;
+}
+
+int test_vue_automate(){
+	int result = 1;
+
+	{
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 1, 'a', 2 );
+		ajouter_transition( automate, 1, 'a', 3 );
+		ajouter_transition( automate, 2, 'b', 3 );
+		ajouter_etat( automate, 4 );
+		ajouter_etat_initial( automate, 1 );
+		ajouter_etat_final( automate, 3 );
+
+		// L'automate translaté de 10, construit à la main
+		Automate * attendu = creer_automate();
+		ajouter_transition( attendu, 11, 'a', 12 );
+		ajouter_transition( attendu, 11, 'a', 13 );
+		ajouter_transition( attendu, 12, 'b', 13 );
+		ajouter_etat( attendu, 14 );
+		ajouter_etat_initial( attendu, 11 );
+		ajouter_etat_final( attendu, 13 );
+
+		Vue_automate vue = creer_vue_automate( automate, 10 );
+
+		TEST(
+			1
+			&& est_un_etat_de_la_vue( &vue, 11 )
+			&& est_un_etat_de_la_vue( &vue, 14 )
+			&& ! est_un_etat_de_la_vue( &vue, 1 )
+			&& est_un_etat_final_de_la_vue( &vue, 13 )
+			&& ! est_un_etat_final_de_la_vue( &vue, 3 )
+			, result
+		);
+
+		Ensemble * fins = creer_ensemble( NULL, NULL, NULL );
+		pour_tout_voisin_vue( &vue, 11, 'a', ajouter_voisin, fins );
+		TEST(
+			1
+			&& taille_ensemble( fins ) == 2
+			&& est_dans_l_ensemble( fins, 12 )
+			&& est_dans_l_ensemble( fins, 13 )
+			, result
+		);
+		liberer_ensemble( fins );
+
+		int conforme = vue_conforme( &vue, attendu );
+		TEST( conforme, result );
+
+		// Une transition en trop ou en moins est détectée
+		Automate * plus = copier_automate( attendu );
+		ajouter_transition( plus, 13, 'a', 11 );
+		conforme = vue_conforme( &vue, plus );
+		TEST( ! conforme, result );
+		Vue_automate vue_plus = creer_vue_automate( plus, 0 );
+		conforme = vue_conforme( &vue_plus, attendu );
+		TEST( ! conforme, result );
+
+		// La copie d'une vue, et translater_automate_entier(), donnent 
+		// l'automate attendu
+		Automate * copie = creer_automate();
+		ajouter_vue_automate( copie, &vue );
+		Vue_automate vue_copie = creer_vue_automate( copie, 0 );
+		conforme = vue_conforme( &vue_copie, attendu );
+		TEST( conforme, result );
+		Automate * translate = translater_automate_entier( automate, 10 );
+		Vue_automate vue_translate = creer_vue_automate( translate, 0 );
+		conforme = vue_conforme( &vue_translate, attendu );
+		TEST( conforme, result );
+
+		liberer_automate( translate );
+		liberer_automate( copie );
+		liberer_automate( plus );
+		liberer_automate( attendu );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_vue_automate() ){ return 1; };
+
+	return 0;
+	
+}